@@ -1,31 +1,111 @@
 #include "ListNode.h"
+#include "listsort.h"
 #include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <iterator>
 #include <utility>
 
 using namespace std;
 
+#define LIST_DEDUP_LOAD_SHIFT 1 // deduplicate中散列表的槽数不少于节点数的2^LIST_DEDUP_LOAD_SHIFT倍
+#define LIST_SKIP_MIN 16 // 按秩访问时，需走过的节点数不少于此才考虑借助跳跃索引；亦为索引步长的下限
+
+// 列表的双向迭代器：包装节点位置，end()对应trailer；V为T时可写，为T const时只读
+template <typename T, typename V = T>
+class ListIterator
+{
+private:
+    ListNodePosi(T) _p;
+
+public:
+    typedef bidirectional_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef ptrdiff_t difference_type;
+    typedef V *pointer;
+    typedef V &reference;
+
+    ListIterator(ListNodePosi(T) p = NULL) : _p(p) {}
+    ListIterator(ListIterator<T> const &i) : _p(i.node()) {} // 可写迭代器可以转为只读迭代器
+    ListNodePosi(T) node() const { return _p; }
+    V &operator*() const { return _p->data; }
+    V *operator->() const { return &_p->data; }
+    ListIterator &operator++()
+    {
+        _p = _p->succ;
+        return *this;
+    }
+    ListIterator operator++(int)
+    {
+        ListIterator i(*this);
+        _p = _p->succ;
+        return i;
+    }
+    ListIterator &operator--()
+    {
+        _p = _p->pred;
+        return *this;
+    }
+    ListIterator operator--(int)
+    {
+        ListIterator i(*this);
+        _p = _p->pred;
+        return i;
+    }
+    bool operator==(ListIterator const &i) const { return _p == i._p; }
+    bool operator!=(ListIterator const &i) const { return _p != i._p; }
+};
+
 template <typename T>
 class List
 {
 private:
-    int _size;
+    Rank _size;
     ListNodePosi(T) header;
     ListNodePosi(T) trailer;
+    // 按秩访问的缓存（operator[]因此不宜在多个线程中并发调用）：
+    // 游标记录最近访问的秩与节点；跳跃索引_skip[i]为秩i * _stride的节点，约sqrt(n)项
+    // 除insertAsLast外，任何结构变化都令二者作废；索引在此后走过的节点累计达到规模时才重建，重建代价由此前的遍历分摊
+    mutable Rank _cursorRank;
+    mutable ListNodePosi(T) _cursor;
+    mutable ListNodePosi(T) *_skip;
+    mutable Rank _skipCount, _skipCapacity, _stride, _walked;
+
+    void invalidate()
+    {
+        _cursor = NULL;
+        _skipCount = 0;
+    }
+    static Rank dist(Rank a, Rank b) { return a < b ? b - a : a - b; }
+    static size_t hashSlot(size_t h, int bits) { return (size_t)(((unsigned long long)h * 0x9E3779B97F4A7C15ull) >> (64 - bits)); } // 乘法散列，取高bits位
+    void buildSkip() const;
+    struct NodeLess // 比较两节点的数据，供relinkMerge等使用
+    {
+        bool operator()(ListNodePosi(T) a, ListNodePosi(T) b) const { return a->data < b->data; }
+    };
+    void discard(ListNodePosi(T) p); // 摘除并释放节点p，不取出其数据
 
 protected:
     void init();
-    int clear();
-    void copyNodes(ListNodePosi(T), int);
-    void merge(ListNodePosi(T) &, int, List<T> &, ListNodePosi(T), int);
-    void mergeSort(ListNodePosi(T) &, int);
-    void selectionSort(ListNodePosi(T), int);
-    void insertionSort(ListNodePosi(T), int);
+    ListNodePosi(T) locate(Rank r) const;
+    Rank clear();
+    void copyNodes(ListNodePosi(T), Rank);
+    void merge(ListNodePosi(T) &, Rank, List<T> &, ListNodePosi(T), Rank);
+    void mergeSort(ListNodePosi(T) &, Rank);
+    void naturalMergeSort(ListNodePosi(T) &, Rank);
+    void selectionSort(ListNodePosi(T), Rank);
+    void insertionSort(ListNodePosi(T), Rank);
 
 public:
+    typedef T value_type;
+    typedef ListIterator<T> iterator;
+    typedef ListIterator<T, T const> const_iterator;
+
     List() { init(); }
     List(List<T> const &L);
-    List(List<T> const &L, Rank r, int n);
-    List(ListNodePosi(T) p, int n);
+    List(List<T> const &L, Rank r, Rank n);
+    List(ListNodePosi(T) p, Rank n);
     ~List();
 
     Rank size() const
@@ -45,40 +125,49 @@ public:
     {
         return trailer->pred;
     }
+    iterator begin() { return iterator(header->succ); }
+    iterator end() { return iterator(trailer); }
+    const_iterator begin() const { return const_iterator(header->succ); }
+    const_iterator end() const { return const_iterator(trailer); }
     bool valid(ListNodePosi(T) p)
     {
         return p && (trailer != p) && (header != p);
     }
-    int disordered() const;
+    Rank disordered() const;
     ListNodePosi(T) find(T const &e) const
     {
         return find(e, _size, trailer);
     }
-    ListNodePosi(T) find(T const &e, int n, ListNodePosi(T) p) const;
+    ListNodePosi(T) find(T const &e, Rank n, ListNodePosi(T) p) const;
     ListNodePosi(T) search(T const &e) const
     {
         return search(e, _size, trailer);
     }
-    ListNodePosi(T) search(T const &e, int n, ListNodePosi(T) p) const;
-    ListNodePosi(T) selectMax(ListNodePosi(T) p, int n);
+    ListNodePosi(T) search(T const &e, Rank n, ListNodePosi(T) p) const;
+    ListNodePosi(T) selectMax(ListNodePosi(T) p, Rank n);
     ListNodePosi(T) selectMax() { return selectMax(header->succ, _size); }
     ListNodePosi(T) insertAsFirst(T const &e);
     ListNodePosi(T) insertAsLast(T const &e);
     ListNodePosi(T) insertA(ListNodePosi(T) p, T const &e);
     ListNodePosi(T) insertB(ListNodePosi(T) p, T const &e);
     T remove(ListNodePosi(T) p);
+    void splice(ListNodePosi(T) p, List<T> &L, ListNodePosi(T) x);
+    void splice(ListNodePosi(T) p, List<T> &L, ListNodePosi(T) lo, ListNodePosi(T) hi, Rank n);
+    void splice(ListNodePosi(T) p, List<T> &L) { splice(p, L, L.first(), L.trailer, L._size); }
     void merge(List<T> &L)
     {
-        merge(first(), _size, L, L.first(), L._size);
+        ListNodePosi(T) p = first();
+        merge(p, _size, L, L.first(), L._size);
     }
-    void sort(ListNodePosi(T) p, int n);
+    void sort(ListNodePosi(T) p, Rank n);
     void sort() { sort(first(), _size); }
-    int deduplicate();
-    int uniquify();
+    Rank deduplicate();
+    Rank deduplicate_sorted() { return uniquify(); } // 已知有序时去重：只比较相邻节点，O(n)，无需散列
+    Rank uniquify();
     void reverse();
     void traverse(void (*)(T &));
     template <typename VST>
-    void traverse(VST &);
+    void traverse(VST &&visit);
 };
 
 template <typename T>
@@ -91,21 +180,69 @@ void List<T>::init()
     trailer->pred = header;
     trailer->succ = NULL;
     _size = 0;
+    _cursor = NULL;
+    _skip = NULL;
+    _skipCount = _skipCapacity = _stride = _walked = 0;
 }
 
 template <typename T>
-T &List<T>::operator[](Rank r) const
+void List<T>::buildSkip() const
 {
+    _stride = max((Rank)LIST_SKIP_MIN, (Rank)sqrt((double)_size));
+    Rank count = (_size + _stride - 1) / _stride;
+    if (_skipCapacity < count)
+    {
+        delete[] _skip;
+        _skip = new ListNodePosi(T)[_skipCapacity = count * 2];
+    }
     ListNodePosi(T) p = first();
-    while (0 < r--)
+    for (Rank i = 0; i < count; i++)
     {
-        p = p->succ;
+        _skip[i] = p;
+        for (Rank k = 0; k < _stride && p != trailer; k++)
+            p = p->succ;
     }
-    return p->data;
+    _skipCount = count;
+    _walked = 0;
 }
 
 template <typename T>
-ListNodePosi(T) List<T>::find(T const &e, int n, ListNodePosi(T) p) const
+ListNodePosi(T) List<T>::locate(Rank r) const // 秩为r的节点（0 <= r < _size）：自header、trailer、游标及跳跃索引中最近者出发
+{
+    ListNodePosi(T) p = header;
+    Rank pr = -1;
+    if (_size - r < r - pr)
+        p = trailer, pr = _size;
+    if (_cursor && dist(_cursorRank, r) < dist(pr, r))
+        p = _cursor, pr = _cursorRank;
+    if (LIST_SKIP_MIN <= dist(pr, r))
+    {
+        if (!_skipCount && _size <= _walked)
+            buildSkip();
+        if (_skipCount)
+        {
+            Rank i = min((r + _stride / 2) / _stride, _skipCount - 1);
+            if (dist(i * _stride, r) < dist(pr, r))
+                p = _skip[i], pr = i * _stride;
+        }
+    }
+    _walked += dist(pr, r);
+    while (pr < r)
+        p = p->succ, pr++;
+    while (r < pr)
+        p = p->pred, pr--;
+    _cursorRank = r;
+    return _cursor = p;
+}
+
+template <typename T>
+T &List<T>::operator[](Rank r) const
+{
+    return locate(r)->data;
+}
+
+template <typename T>
+ListNodePosi(T) List<T>::find(T const &e, Rank n, ListNodePosi(T) p) const
 {
     while (0 < n--)
     {
@@ -118,12 +255,13 @@ ListNodePosi(T) List<T>::find(T const &e, int n, ListNodePosi(T) p) const
 template <typename T>
 ListNodePosi(T) List<T>::insertAsFirst(T const &e)
 {
+    invalidate();
     _size++;
     return header->insertAsSucc(e);
 }
 
 template <typename T>
-ListNodePosi(T) List<T>::insertAsLast(T const &e)
+ListNodePosi(T) List<T>::insertAsLast(T const &e) // 已有节点的秩不变，按秩访问的缓存依然有效
 {
     _size++;
     return trailer->insertAsPred(e);
@@ -132,6 +270,7 @@ ListNodePosi(T) List<T>::insertAsLast(T const &e)
 template <typename T>
 ListNodePosi(T) List<T>::insertA(ListNodePosi(T) p, T const &e)
 {
+    invalidate();
     _size++;
     return p->insertAsSucc(e);
 }
@@ -139,6 +278,7 @@ ListNodePosi(T) List<T>::insertA(ListNodePosi(T) p, T const &e)
 template <typename T>
 ListNodePosi(T) List<T>::insertB(ListNodePosi(T) p, T const &e)
 {
+    invalidate();
     _size++;
     return p->insertAsPred(e);
 }
@@ -161,7 +301,7 @@ ListNodePosi(T) ListNode<T>::insertAsSucc(T const &e)
     return x;
 }
 template <typename T>
-void List<T>::copyNodes(ListNodePosi(T) p, int n)
+void List<T>::copyNodes(ListNodePosi(T) p, Rank n)
 {
     init();
     while (n--)
@@ -172,7 +312,7 @@ void List<T>::copyNodes(ListNodePosi(T) p, int n)
 }
 
 template <typename T>
-List<T>::List(ListNodePosi(T) p, int n)
+List<T>::List(ListNodePosi(T) p, Rank n)
 {
     copyNodes(p, n);
 }
@@ -184,55 +324,116 @@ List<T>::List(List<T> const &L)
 }
 
 template <typename T>
-List<T>::List(List<T> const &L, int r, int n)
+List<T>::List(List<T> const &L, Rank r, Rank n)
 {
-    copyNodes(L[r], n);
+    copyNodes(L.locate(r), n);
 }
 
 template <typename T>
-T List<T>::remove(ListNodePosi(T) p)
+void List<T>::discard(ListNodePosi(T) p)
 {
-    T e = p->data;
+    invalidate();
     p->pred->succ = p->succ;
     p->succ->pred = p->pred;
     delete p;
     _size--;
+}
+
+template <typename T>
+T List<T>::remove(ListNodePosi(T) p)
+{
+    T e = std::move(p->data); // 节点随即释放，数据移出即可
+    discard(p);
     return e;
 }
 
+template <typename T>
+void List<T>::splice(ListNodePosi(T) p, List<T> &L, ListNodePosi(T) x) // 将L（可以是本列表）中的节点x移至p之前：只改链接，O(1)
+{
+    if (p == x || p->pred == x)
+        return;
+    invalidate();
+    L.invalidate();
+    x->pred->succ = x->succ;
+    x->succ->pred = x->pred;
+    x->pred = p->pred;
+    x->succ = p;
+    p->pred->succ = x;
+    p->pred = x;
+    if (&L != this)
+    {
+        L._size--;
+        _size++;
+    }
+}
+
+template <typename T>
+void List<T>::splice(ListNodePosi(T) p, List<T> &L, ListNodePosi(T) lo, ListNodePosi(T) hi, Rank n) // 将L中[lo, hi)共n个节点整体移至p之前，p不得位于其中；O(1)
+{
+    if (lo == hi || p == hi)
+        return;
+    invalidate();
+    L.invalidate();
+    ListNodePosi(T) last = hi->pred;
+    lo->pred->succ = hi;
+    hi->pred = lo->pred;
+    lo->pred = p->pred;
+    last->succ = p;
+    p->pred->succ = lo;
+    p->pred = last;
+    if (&L != this)
+    {
+        L._size -= n;
+        _size += n;
+    }
+}
+
 template <typename T>
 List<T>::~List()
 {
     clear();
     delete header;
     delete trailer;
+    delete[] _skip;
 }
 
 template <typename T>
-int List<T>::clear()
+Rank List<T>::clear()
 {
-    int oldSize = _size;
+    Rank oldSize = _size;
     while (0 < _size)
     {
-        remove(header->succ);
+        discard(header->succ);
     }
     return oldSize;
 }
 
 template <typename T>
-int List<T>::deduplicate()
+Rank List<T>::deduplicate() // 散列去重：保留各元素首次出现者，相对次序不变，一趟完成，期望O(n)；需要std::hash<T>与==
 {
     if (_size < 2)
         return 0;
-    int OldSize = _size;
-    ListNodePosi(T) p = header;
-    Rank r = 0;
-    while (trailer != (p = p->succ))
+    int bits = 1;
+    while ((Rank)1 << bits < _size << LIST_DEDUP_LOAD_SHIFT)
+        bits++;
+    size_t mask = ((size_t)1 << bits) - 1;
+    ListNodePosi(T) *slot = new ListNodePosi(T)[mask + 1](); // 槽中存放已保留的节点，NULL为空
+    hash<T> h;
+    Rank oldSize = _size;
+    for (ListNodePosi(T) p = first(); p != trailer;)
     {
-        ListNodePosi(T) q = find(p->data, r, p);
-        q ? remove(q) : r++;
+        ListNodePosi(T) next = p->succ;
+        size_t j = hashSlot(h(p->data), bits);
+        while (slot[j] && !(slot[j]->data == p->data))
+            j = (j + 1) & mask;
+        if (slot[j])
+            discard(p); // 重复
+        else
+            slot[j] = p;
+        p = next;
     }
-    return OldSize - _size;
+    delete[] slot;
+    return oldSize - _size;
 }
 
 template <typename T>
@@ -244,18 +445,18 @@ void List<T>::traverse(void (*visit)(T &))
 
 template <typename T>
 template <typename VST>
-void List<T>::traverse(VST &visit)
+void List<T>::traverse(VST &&visit)
 {
     for (ListNodePosi(T) p = header->succ; p != trailer; p = p->succ)
         visit(p->data);
 }
 
 template <typename T>
-int List<T>::uniquify()
+Rank List<T>::uniquify()
 {
     if (_size < 2)
         return 0;
-    int oldSize = _size;
+    Rank oldSize = _size;
     ListNodePosi(T) p = first();
     ListNodePosi(T) q;
     while (trailer != (q = p->succ))
@@ -263,117 +464,103 @@ int List<T>::uniquify()
         if (p->data != q->data)
             p = q;
         else
-            remove(q);
+            discard(q);
     }
     return oldSize - _size;
 }
 
 template <typename T>
-ListNodePosi(T) List<T>::search(T const &e, int n, ListNodePosi(T) p) const
+ListNodePosi(T) List<T>::search(T const &e, Rank n, ListNodePosi(T) p) const // 在p的n个前驱中找不大于e的最后者；均大于e时返回这n个节点之前的位置
 {
-    while (0 <= n--)
-    {
-        if (((p = p->pred)->data) <= e)
-            break;
-    }
-    return p;
+    while (0 < n--)
+        if (!(e < (p = p->pred)->data))
+            return p;
+    return p->pred;
 }
 
 template <typename T>
-void List<T>::sort(ListNodePosi(T) p, int n)
+void List<T>::sort(ListNodePosi(T) p, Rank n) // 自然归并排序：稳定，已有序时O(n)，最坏O(nlogn)
 {
-    switch (rand() % 3)
-    {
-    case 1:
-        insertionSort(p, n);
-        break;
-    case 2:
-        selectionSort(p, n);
-        break;
-        default:
-        mergeSort(p, n);
-        break;
-    }
+    naturalMergeSort(p, n);
 }
 
 template <typename T>
-void List<T>::insertionSort(ListNodePosi(T) p, int n)
+void List<T>::insertionSort(ListNodePosi(T) p, Rank n) // 节点原地重新链接，不分配、不复制元素；稳定
 {
-    for (int r = 0; r < n; r++)
+    for (Rank r = 0; r < n; r++)
     {
-        insertA(search(p->data, r, p), p->data);
-        p = p->succ;
-        remove(p->pred);
+        ListNodePosi(T) next = p->succ;
+        splice(search(p->data, r, p)->succ, *this, p);
+        p = next;
     }
 }
 
 template <typename T>
-void List<T>::selectionSort(ListNodePosi(T) p, int n)
+void List<T>::selectionSort(ListNodePosi(T) p, Rank n)
 {
     ListNodePosi(T) head = p->pred;
     ListNodePosi(T) tail = p;
-    for (int i = 0; i < n; i++)
+    for (Rank i = 0; i < n; i++)
         tail = tail->succ;
     while (1 < n)
     {
         ListNodePosi(T) max = selectMax(head->succ, n);
-        insertB(tail, remove(max));
-        tail = tail->pred;
+        splice(tail, *this, max); // 移至已排序部分之首，不分配、不复制元素
+        tail = max;
         n--;
     }
 }
 
 template <typename T>
-ListNodePosi(T) List<T>::selectMax(ListNodePosi(T) p, int n)
+ListNodePosi(T) List<T>::selectMax(ListNodePosi(T) p, Rank n) // 多个最大者时取最靠后者，故选择排序稳定
 {
     ListNodePosi(T) max = p;
     for (ListNodePosi(T) cur = p; 1 < n; n--)
-        if (!lt((cur = cur->succ)->data, max->data))
+        if (!((cur = cur->succ)->data < max->data))
             max = cur;
     return max;
 }
 
 template <typename T>
-void List<T>::merge(ListNodePosi(T) & p, int n, List<T> &L, ListNodePosi(T) q, int m)
+void List<T>::merge(ListNodePosi(T) & p, Rank n, List<T> &L, ListNodePosi(T) q, Rank m) // 将L中自q起的m个节点归并入自p起的n个节点：只改链接；稳定
 {
-    ListNodePosi(T) pp = p->pred;
-    while (0 < m)
+    invalidate();
+    L.invalidate();
+    relinkMerge(p, n, q, m, NodeLess());
+    if (&L != this)
     {
-        if ((0 < n) && (p->data <= q->data))
-        {
-            if (q == (p = p->succ))
-                break;
-            n--;
-        }
-        else
-        {
-            insertB(p, L.remove((q = q->succ)->pred));
-            m--;
-        }
+        L._size -= m;
+        _size += m;
     }
-    p = pp->succ;
 }
 
 template <typename T>
-void List<T>::mergeSort(ListNodePosi(T) & p, int n)
+void List<T>::mergeSort(ListNodePosi(T) & p, Rank n)
 {
     if (n < 2)
         return;
-    int m = n >> 1;
+    Rank m = n >> 1;
     ListNodePosi(T) q = p;
-    for (int i = 0; i < m; i++)
+    for (Rank i = 0; i < m; i++)
         q = q->succ;
     mergeSort(p, m);
     mergeSort(q, n - m);
     merge(p, m, *this, q, n - m);
 }
 
+template <typename T>
+void List<T>::naturalMergeSort(ListNodePosi(T) & p, Rank n) // 见listsort.h
+{
+    invalidate();
+    relinkNaturalMergeSort(p, n, NodeLess());
+}
+
 template <typename T>
 void List<T>::reverse()
 {
     ListNodePosi(T) p = header;
     ListNodePosi(T) q = trailer;
-    for (int i = 1; i < _size; i += 2)
+    for (Rank i = 1; i < _size; i += 2)
     {
         swap((p = p->succ)->data, (q = q->pred)->data);
     }
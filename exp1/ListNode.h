@@ -1,6 +1,11 @@
 #include <cstddef>
+#include "nodepool.h"
 
-typedef int Rank;
+#ifndef LIST_NODE_POOL
+#define LIST_NODE_POOL 1 // 节点取自NodePool；定义为0则退回全局new/delete
+#endif
+
+#include "rank.h"
 #define ListNodePosi(T) ListNode<T> *
 
 template <typename T>
@@ -15,4 +20,9 @@ struct ListNode
 
     ListNodePosi(T) insertAsPred(T const &e);
     ListNodePosi(T) insertAsSucc(T const &e);
+
+#if LIST_NODE_POOL
+    static void *operator new(size_t) { return NodePool<sizeof(ListNode), alignof(ListNode)>::allocate(); }
+    static void operator delete(void *p) { NodePool<sizeof(ListNode), alignof(ListNode)>::deallocate(p); }
+#endif
 };
\ No newline at end of file
@@ -0,0 +1,104 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+// 单调内存池：自大块中顺序切分，单次释放不回收空间，release()或析构时一次性归还全部内存
+// 适用于生命期相同的一批临时对象（如一次请求中构造的若干向量）
+class Arena
+{
+private:
+    struct Block
+    {
+        Block *next;
+        size_t size; // 数据区字节数
+    };
+    Block *_head;
+    char *_cur, *_end; // 当前块中尚未使用的区间
+    size_t _blockSize;
+    size_t _blocks; // 已向系统申请的块数
+
+    static size_t header() { return (sizeof(Block) + alignof(max_align_t) - 1) & ~(alignof(max_align_t) - 1); } // 块头，补齐至max_align_t
+    void grow(size_t n, size_t align)
+    {
+        size_t size = (n + align < _blockSize) ? _blockSize : n + align; // 过大的请求单独成块
+        Block *b = (Block *)::operator new(header() + size);
+        b->next = _head;
+        b->size = size;
+        _head = b;
+        _cur = (char *)b + header();
+        _end = _cur + size;
+        _blocks++;
+    }
+
+public:
+    Arena(size_t blockSize = 64 * 1024) : _head(NULL), _cur(NULL), _end(NULL), _blockSize(blockSize), _blocks(0) {}
+    Arena(Arena const &) = delete;
+    Arena &operator=(Arena const &) = delete;
+    ~Arena() { release(); }
+
+    void *allocate(size_t n, size_t align) // align须为2的幂
+    {
+        uintptr_t p = ((uintptr_t)_cur + align - 1) & ~(uintptr_t)(align - 1);
+        if (!_cur || (uintptr_t)_end < p + n)
+        {
+            grow(n, align);
+            p = ((uintptr_t)_cur + align - 1) & ~(uintptr_t)(align - 1);
+        }
+        _cur = (char *)(p + n);
+        return (void *)p;
+    }
+    void release() // 归还全部内存；此前从本池分配的对象须已析构
+    {
+        while (_head)
+        {
+            Block *b = _head;
+            _head = b->next;
+            ::operator delete((void *)b);
+        }
+        _cur = _end = NULL;
+    }
+    void reset() // 回绕至首个空闲位置，只保留最近申请的一块，重复使用时不再访问堆；此前分配的对象须已析构
+    {
+        if (!_head)
+            return;
+        Block *b = _head->next;
+        while (b)
+        {
+            Block *next = b->next;
+            ::operator delete((void *)b);
+            b = next;
+        }
+        _head->next = NULL;
+        _cur = (char *)_head + header();
+        _end = _cur + _head->size;
+    }
+    size_t blocks() const { return _blocks; }
+};
+
+// 自Arena分配的分配器：deallocate为空操作，空间随Arena整体释放
+// 同一Arena上的分配器彼此相等，因此Vector之间的移动可以直接接管空间
+template <typename T>
+class ArenaAllocator
+{
+private:
+    Arena *_arena;
+    template <typename U>
+    friend class ArenaAllocator;
+
+public:
+    typedef T value_type;
+    ArenaAllocator(Arena &a) : _arena(&a) {}
+    template <typename U>
+    ArenaAllocator(ArenaAllocator<U> const &a) : _arena(a._arena) {}
+    T *allocate(size_t n) { return (T *)_arena->allocate(n * sizeof(T), alignof(T)); }
+    void deallocate(T *, size_t) {}
+    template <typename U>
+    bool operator==(ArenaAllocator<U> const &a) const { return _arena == a._arena; }
+    template <typename U>
+    bool operator!=(ArenaAllocator<U> const &a) const { return _arena != a._arena; }
+};
+
+#endif
@@ -0,0 +1,51 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <chrono>
+#include <random>
+
+// 基准测试公用的计时与数据生成工具
+typedef std::chrono::high_resolution_clock::time_point TimePoint;
+typedef std::chrono::duration<double, std::milli> DurationMs;
+
+template <typename F>
+double measureMs(F f) // 运行f一次，返回耗时（毫秒）
+{
+    TimePoint start = std::chrono::high_resolution_clock::now();
+    f();
+    return DurationMs(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+typedef enum
+{
+    INPUT_SORTED,
+    INPUT_REVERSED,
+    INPUT_RANDOM,
+    INPUT_FEW_UNIQUE
+} InputKind;
+
+static const char *const inputName[] = {"sorted", "reversed", "random", "few-unique"};
+
+template <typename V>
+void fillInput(V &v, int n, InputKind kind, unsigned seed = 2025) // v须为空向量
+{
+    std::mt19937 g(seed);
+    for (int i = 0; i < n; i++)
+        switch (kind)
+        {
+        case INPUT_SORTED:
+            v.insert(i);
+            break;
+        case INPUT_REVERSED:
+            v.insert(n - i);
+            break;
+        case INPUT_RANDOM:
+            v.insert((int)(g() >> 1));
+            break;
+        default:
+            v.insert((int)(g() % 8));
+            break;
+        }
+}
+
+#endif
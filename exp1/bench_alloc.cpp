@@ -0,0 +1,89 @@
+// 短命小向量的堆分配次数与耗时：默认分配器、Arena、SmallVector
+// 模拟1.1.cpp的generateRandomComplexVec与1.3.cpp的findModInRange：每次请求构造一个含重复元素的小向量，再筛出一个子向量
+// 编译：g++ -O2 -std=c++17 bench_alloc.cpp -o output/bench_alloc.exe
+#include "vector.h"
+#include "arena.h"
+#include "smallvector.h"
+#include "bench.h"
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+static long long allocCount = 0; // 全局operator new的调用次数
+
+void *operator new(size_t n)
+{
+    allocCount++;
+    if (void *p = malloc(n ? n : 1))
+        return p;
+    throw std::bad_alloc();
+}
+void operator delete(void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+
+struct Point
+{
+    double re, im;
+    double mod2() const { return re * re + im * im; }
+};
+
+template <typename V>
+static double request(V &vec, V &result, std::mt19937 &g, int n) // vec、result须为空向量
+{
+    for (int i = 0; i < n; i++)
+        vec.insert(Point{(double)(g() % 200) - 100, (double)(g() % 200) - 100});
+    for (int i = 0; i < n / 5; i++)
+        vec.insert(vec[g() % n]);
+    for (Rank i = 0; i < vec.size(); i++)
+        if (vec[i].mod2() < 50 * 50)
+            result.insert(vec[i]);
+    return result.size() ? result[0].re : 0;
+}
+
+int main(int argc, char *argv[])
+{
+    int requests = argc > 1 ? atoi(argv[1]) : 1000000, n = 10;
+    double sink = 0;
+    printf("=== %d requests, %d + %d elements each ===\n", requests, n, n / 5);
+    printf("%-24s | %12s | %14s | %8s\n", "vector", "allocations", "allocs/request", "ms");
+
+    std::mt19937 g(2025);
+    long long before = allocCount;
+    double ms = measureMs([&]() {
+        for (int r = 0; r < requests; r++)
+        {
+            Vector<Point> vec, result;
+            sink += request(vec, result, g, n);
+        }
+    });
+    printf("%-24s | %12lld | %14.2f | %8.2f\n", "Vector<Point>", allocCount - before, (double)(allocCount - before) / requests, ms);
+
+    g.seed(2025);
+    before = allocCount;
+    Arena arena;
+    ms = measureMs([&]() {
+        for (int r = 0; r < requests; r++)
+        {
+            {
+                ArenaAllocator<Point> a(arena);
+                Vector<Point, ArenaAllocator<Point>> vec(DEFAULT_CAPACITY, a), result(DEFAULT_CAPACITY, a);
+                sink += request(vec, result, g, n);
+            }
+            arena.reset(); // 请求结束，一次性回收
+        }
+    });
+    printf("%-24s | %12lld | %14.2f | %8.2f\n", "Vector<Point, Arena>", allocCount - before, (double)(allocCount - before) / requests, ms);
+
+    g.seed(2025);
+    before = allocCount;
+    ms = measureMs([&]() {
+        for (int r = 0; r < requests; r++)
+        {
+            SmallVector<Point, 16> vec, result;
+            sink += request(vec, result, g, n);
+        }
+    });
+    printf("%-24s | %12lld | %14.2f | %8.2f\n", "SmallVector<Point, 16>", allocCount - before, (double)(allocCount - before) / requests, ms);
+    printf("(checksum %g)\n", sink);
+    return 0;
+}
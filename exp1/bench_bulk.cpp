@@ -0,0 +1,33 @@
+// 批量插入/删除与逐个insert/remove的耗时对比
+// 编译：g++ -O2 -std=c++17 bench_bulk.cpp -o output/bench_bulk.exe
+#include "vector.h"
+#include "bench.h"
+#include <cstdio>
+#include <cstdlib>
+
+int main(int argc, char *argv[])
+{
+    int n = argc > 1 ? atoi(argv[1]) : 100000;
+    int ks[] = {100, 1000, 10000};
+    Vector<int> base, src;
+    for (int i = 0; i < n; i++)
+        base.insert(i);
+    for (int i = 0; i < ks[2]; i++)
+        src.insert(-i);
+    printf("=== insert k elements at the middle of a %d-element Vector<int> (ms) ===\n", n);
+    printf("%8s | %12s | %12s | %12s\n", "k", "k x insert", "range", "fill");
+    for (int k : ks)
+    {
+        Vector<int> a(base), b(base), c(base);
+        double t0 = measureMs([&]() { for (int i = 0; i < k; i++) a.insert(n / 2 + i, src[i]); });
+        double t1 = measureMs([&]() { b.insert(n / 2, &src[0], &src[0] + k); });
+        double t2 = measureMs([&]() { c.insert(n / 2, k, -1); });
+        printf("%8d | %12.3f | %12.3f | %12.3f\n", k, t0, t1, t2);
+    }
+    printf("\n=== remove every odd element of a %d-element Vector<int> (ms) ===\n", n);
+    Vector<int> a(base), b(base);
+    double t0 = measureMs([&]() { for (Rank i = 0; i < a.size();) (a[i] & 1) ? (void)a.remove(i) : (void)i++; });
+    double t1 = measureMs([&]() { b.erase_if([](int x) { return x & 1; }); });
+    printf("remove loop %.3f, erase_if %.3f, sizes %lld/%lld\n", t0, t1, a.size(), b.size());
+    return 0;
+}
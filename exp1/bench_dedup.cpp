@@ -0,0 +1,99 @@
+// 无序向量去重：逐个find + remove（原实现）、散列去重、排序去重的耗时对比；以及列表的逐个find去重与散列去重
+// 编译：g++ -O2 -std=c++17 bench_dedup.cpp -o output/bench_dedup.exe
+#include "vector.h"
+#include "List.h"
+#include "bench.h"
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+
+template <typename T>
+Rank naiveDeduplicate(Vector<T> &v) // 原deduplicate：O(n^2)次比较 + O(n^2)次移动
+{
+    Rank oldSize = v.size();
+    Rank i = 1;
+    while (i < v.size())
+        if (v.find(v[i], 0, i) < 0)
+            i++;
+        else
+            v.remove(i);
+    return oldSize - v.size();
+}
+
+template <typename T>
+Rank naiveDeduplicate(List<T> &L) // List原deduplicate：对每个节点向前find，O(n^2)次比较
+{
+    Rank oldSize = L.size();
+    Rank r = 0;
+    for (ListNodePosi(T) p = L.first(); p != L.last()->succ;)
+    {
+        ListNodePosi(T) q = L.find(p->data, r, p);
+        p = p->succ;
+        q ? (void)L.remove(q) : (void)r++;
+    }
+    return oldSize - L.size();
+}
+
+template <typename T, typename G>
+void runList(const char *name, int n, G gen)
+{
+    std::mt19937 g(2025);
+    List<T> src;
+    for (int i = 0; i < n; i++)
+        src.insertAsLast(gen(g() % (n / 2)));
+    double naive = -1;
+    Rank removed[3] = {0, 0, 0};
+    if (n <= 100000)
+    {
+        List<T> L(src);
+        naive = measureMs([&]() { removed[0] = naiveDeduplicate(L); });
+    }
+    List<T> L(src), S(src);
+    double ms = measureMs([&]() { removed[1] = L.deduplicate(); });
+    S.sort();
+    double sorted = measureMs([&]() { removed[2] = S.deduplicate_sorted(); });
+    printf("%-8s %10d |", name, n);
+    (naive < 0) ? printf(" %10s |", "-") : printf(" %10.2f |", naive);
+    printf(" %10.2f | %10.2f | removed %lld/%lld\n", ms, sorted, removed[1], removed[2]);
+}
+
+template <typename T, typename G>
+void run(const char *name, int n, G gen)
+{
+    std::mt19937 g(2025);
+    Vector<T> src;
+    for (int i = 0; i < n; i++)
+        src.insert(gen(g() % (n / 2))); // 约一半元素重复
+    double ms[3] = {-1, -1, -1};
+    Rank removed[3] = {0, 0, 0};
+    if (n <= 100000)
+    {
+        Vector<T> v(src);
+        ms[0] = measureMs([&]() { removed[0] = naiveDeduplicate(v); });
+    }
+    Vector<T> v(src), w(src);
+    ms[1] = measureMs([&]() { removed[1] = v.deduplicate(); });
+    ms[2] = measureMs([&]() { removed[2] = w.deduplicate_ordered(); });
+    printf("%-8s %10d |", name, n);
+    for (int k = 0; k < 3; k++)
+        (ms[k] < 0) ? printf(" %10s |", "-") : printf(" %10.2f |", ms[k]);
+    printf(" removed %lld/%lld\n", removed[1], removed[2]);
+}
+
+int main(int argc, char *argv[])
+{
+    int sizes[] = {10000, 100000, argc > 1 ? atoi(argv[1]) : 1000000};
+    printf("%-8s %10s | %10s | %10s | %10s |\n", "type", "n", "naive", "hash", "ordered");
+    for (int n : sizes)
+        run<int>("int", n, [](unsigned x) { return (int)x; });
+    for (int n : sizes)
+        run<std::string>("string", n, [](unsigned x) { return "key-" + std::to_string(x); });
+
+    printf("\nList\n%-8s %10s | %10s | %10s | %10s |\n", "type", "n", "naive", "hash", "sorted");
+    for (int n : sizes)
+        runList<int>("int", n, [](unsigned x) { return (int)x; });
+    for (int n : sizes)
+        runList<std::string>("string", n, [](unsigned x) { return "key-" + std::to_string(x); });
+    return 0;
+}
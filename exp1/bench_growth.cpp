@@ -0,0 +1,38 @@
+// 各扩容策略下连续追加的耗时、重分配次数与内存占用；以及在缩容阈值附近反复插入删除时的重分配次数
+// 编译：g++ -O2 -std=c++17 bench_growth.cpp -o output/bench_growth.exe
+#include "vector.h"
+#include "bench.h"
+#include <cstdio>
+#include <cstdlib>
+
+template <typename G>
+void run(const char *name, int n)
+{
+    Vector<int, allocator<int>, G> v;
+    double ms = measureMs([&]() { for (int i = 0; i < n; i++) v.insert(i); });
+    MemoryStats m = v.memory_stats();
+    long long grow = m.reallocations;
+    Rank lo = v.capacity() / SHRINK_LOAD - 1; // 删至缩容阈值以下，随后在其附近往复
+    v.remove(lo, v.size());
+    long long before = v.memory_stats().reallocations;
+    for (int r = 0; r < 1000000; r++)
+    {
+        v.insert(r);
+        v.insert(r);
+        v.remove(v.size() - 2, v.size());
+    }
+    printf("%-16s | %8.2f | %10lld | %10.1f | %10.1f | %6.1f%% | %10lld\n", name, ms, grow, m.reserved / 1048576.0, m.used / 1048576.0,
+           100.0 * m.used / m.reserved, v.memory_stats().reallocations - before);
+}
+
+int main(int argc, char *argv[])
+{
+    int n = argc > 1 ? atoi(argv[1]) : 10000000;
+    printf("=== append %d ints, then 1e6 insert/remove rounds near the shrink threshold ===\n", n);
+    printf("%-16s | %8s | %10s | %10s | %10s | %7s | %10s\n", "policy", "ms", "reallocs", "reserved MB", "used MB", "load", "oscillation reallocs");
+    run<GrowthDouble>("double", n);
+    run<GrowthOneAndHalf>("1.5x", n);
+    run<GrowthChunk<1 << 16>>("chunk 64K", n);
+    run<GrowthChunk<1 << 20>>("chunk 1M", n);
+    return 0;
+}
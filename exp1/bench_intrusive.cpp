@@ -0,0 +1,74 @@
+// 已有对象加入列表：List<T>（复制对象、分配节点）与IntrusiveList<T>（对象自带挂钩）的对比
+// 编译：g++ -O2 -std=c++17 bench_intrusive.cpp -o output/bench_intrusive.exe
+#include "List.h"
+#include "intrusivelist.h"
+#include "bench.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+struct LruTag
+{
+};
+struct Page : ListHook<LruTag> // 模拟缓存页：键之外另带112字节负载
+{
+    int key;
+    char payload[112];
+    ListNodePosi(Page *) pos; // 使用List<Page *>时记录自己所在的节点，以便O(1)删除
+    Page(int k = 0) : key(k), pos(NULL) { memset(payload, k, sizeof(payload)); }
+    bool operator<(Page const &p) const { return key < p.key; }
+    bool operator==(Page const &p) const { return key == p.key; }
+};
+
+int main(int argc, char *argv[])
+{
+    int n = argc > 1 ? atoi(argv[1]) : 1000000;
+    int touches = 10000000;
+    std::vector<Page> pages;
+    std::mt19937 g(2025);
+    for (int i = 0; i < n; i++)
+        pages.push_back(Page((int)(g() >> 1)));
+    std::vector<int> order(touches);
+    for (int &i : order)
+        i = (int)(g() % n);
+    long long check[3] = {0, 0, 0};
+
+    printf("=== %d pages of %d bytes, %d LRU touches, ms ===\n", n, (int)sizeof(Page), touches);
+    printf("%-16s | %10s | %10s | %10s\n", "container", "insert all", "touches", "sort");
+    {
+        List<Page> L; // 对象复制进列表：无法从对象找到其节点，LRU访问只能在副本上进行
+        double ins = measureMs([&]() { for (Page &p : pages) L.insertAsLast(p); });
+        double sort = measureMs([&]() { L.sort(); });
+        check[0] = L.first()->data.key;
+        printf("%-16s | %10.2f | %10s | %10.2f\n", "List<Page>", ins, "-", sort);
+    }
+    {
+        List<Page *> L; // 存放指针，对象记录自己的节点；LRU访问需释放并重新分配节点
+        double ins = measureMs([&]() { for (Page &p : pages) p.pos = L.insertAsLast(&p); });
+        double touch = measureMs([&]() {
+            for (int i : order)
+            {
+                Page *p = pages[i].pos->data;
+                L.remove(p->pos);
+                p->pos = L.insertAsFirst(p);
+            }
+        });
+        check[1] = L.first()->data->key;
+        printf("%-16s | %10.2f | %10.2f | %10s\n", "List<Page *>", ins, touch, "-");
+    }
+    {
+        IntrusiveList<Page, LruTag> L;
+        double ins = measureMs([&]() { for (Page &p : pages) L.insertAsLast(p); });
+        double sort = measureMs([&]() { L.sort(); }); // 与List<Page>同样在插入后随即排序
+        check[2] = L.first()->key;
+        double touch = measureMs([&]() { for (int i : order) L.moveToFirst(pages[i]); });
+        printf("%-16s | %10.2f | %10.2f | %10.2f\n", "IntrusiveList", ins, touch, sort);
+        if (check[2] != check[0] || L.first()->key != check[1])
+        {
+            printf("mismatch\n");
+            return 1;
+        }
+    }
+    return 0;
+}
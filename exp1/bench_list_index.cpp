@@ -0,0 +1,37 @@
+// List::operator[]的按秩访问：顺序、逆序、随机访问以及穿插修改
+// 编译：g++ -O2 -std=c++17 bench_list_index.cpp -o output/bench_list_index.exe
+#include "List.h"
+#include "bench.h"
+#include <cstdio>
+#include <cstdlib>
+
+int main(int argc, char *argv[])
+{
+    int n = argc > 1 ? atoi(argv[1]) : 100000;
+    int reads = 100000;
+    List<int> L;
+    for (int i = 0; i < n; i++)
+        L.insertAsLast(i);
+    std::mt19937 g(2025);
+    long long sum = 0;
+    printf("=== List<int>::operator[], n = %d ===\n", n);
+    printf("%-24s %10s | %10s | %10s\n", "pattern", "accesses", "ms", "ns/access");
+    double ms = measureMs([&]() { for (int i = 0; i < n; i++) sum += L[i]; });
+    printf("%-24s %10d | %10.2f | %10.2f\n", "forward", n, ms, ms * 1e6 / n);
+    ms = measureMs([&]() { for (int i = n; 0 < i--;) sum += L[i]; });
+    printf("%-24s %10d | %10.2f | %10.2f\n", "backward", n, ms, ms * 1e6 / n);
+    ms = measureMs([&]() { for (int i = 0; i < reads; i++) sum += L[g() % n]; });
+    printf("%-24s %10d | %10.2f | %10.2f\n", "random", reads, ms, ms * 1e6 / reads);
+    ms = measureMs([&]() {
+        for (int i = 0; i < reads / 100; i++)
+        {
+            L.insertAsFirst(L[g() % n]); // 每次修改后再读100次
+            L.remove(L.first());
+            for (int k = 0; k < 100; k++)
+                sum += L[g() % n];
+        }
+    });
+    printf("%-24s %10d | %10.2f | %10.2f\n", "random, 1% writes", reads, ms, ms * 1e6 / reads);
+    printf("(%lld)\n", sum);
+    return 0;
+}
@@ -0,0 +1,112 @@
+// List的各种排序：统计元素复制次数、堆分配次数与耗时；并对比归并排序与自然归并排序在不同输入下的表现
+// 编译：g++ -O2 -std=c++17 -DLIST_NODE_POOL=0 bench_list_sort.cpp -o output/bench_list_sort.exe
+//      （关闭节点池后，节点的分配与释放都经过全局operator new，才会被计入）
+#include "List.h"
+#include "bench.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+static long long allocs = 0;
+void *operator new(size_t n)
+{
+    allocs++;
+    if (void *p = malloc(n ? n : 1))
+        return p;
+    throw std::bad_alloc();
+}
+void operator delete(void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+
+struct Heavy // 复制代价较高的元素：排序键之外另带60字节负载
+{
+    int key;
+    char payload[60];
+    static long long copies;
+    Heavy(int k = 0) : key(k) { memset(payload, k, sizeof(payload)); }
+    Heavy(Heavy const &h) : key(h.key) { memcpy(payload, h.payload, sizeof(payload)), copies++; }
+    Heavy &operator=(Heavy const &h) { key = h.key, memcpy(payload, h.payload, sizeof(payload)), copies++; return *this; }
+    bool operator<(Heavy const &h) const { return key < h.key; }
+};
+long long Heavy::copies = 0;
+
+struct SortableList : List<Heavy> // 逐一测试受保护的排序算法
+{
+    using List<Heavy>::insertionSort;
+    using List<Heavy>::selectionSort;
+    using List<Heavy>::mergeSort;
+    using List<Heavy>::naturalMergeSort;
+};
+
+struct SortableIntList : List<int>
+{
+    using List<int>::mergeSort;
+    using List<int>::naturalMergeSort;
+};
+
+template <typename L, typename E>
+void scatter(int n) // 以乱序释放n个节点：随后建立的列表节点在内存中同样散乱；每次测量之前都调用，使结果不因测量的先后而异
+{
+    L list;
+    std::mt19937 g(1);
+    for (int i = 0; i < n; i++)
+        list.insertAsLast(E((int)(g() >> 1)));
+    ListNodePosi(E) p = list.first();
+    list.mergeSort(p, n);
+}
+
+static const char *const orderName[] = {"sorted", "nearly sorted", "random", "reversed"};
+
+double sortInts(int n, int order, bool natural) // order：0有序，1基本有序（1%的元素错位），2随机，3逆序
+{
+    scatter<SortableIntList, int>(n);
+    SortableIntList L;
+    std::mt19937 g(2025);
+    for (int i = 0; i < n; i++)
+        L.insertAsLast(order == 0 ? i : order == 1 ? (g() % 100 ? i : (int)(g() % n)) : order == 2 ? (int)(g() >> 1) : n - i);
+    ListNodePosi(int) p = L.first();
+    return measureMs([&]() {
+        if (natural)
+            L.naturalMergeSort(p, n);
+        else
+            L.mergeSort(p, n);
+    });
+}
+
+template <typename Sort>
+void run(const char *name, int n, Sort sort)
+{
+    scatter<SortableList, Heavy>(n);
+    SortableList L;
+    std::mt19937 g(2025);
+    for (int i = 0; i < n; i++)
+        L.insertAsLast(Heavy((int)(g() >> 1)));
+    long long c0 = Heavy::copies, a0 = allocs;
+    double ms = measureMs([&]() { sort(L, n); });
+    for (ListNodePosi(Heavy) p = L.first(); p->succ != L.last()->succ; p = p->succ)
+        if (p->succ->data < p->data)
+        {
+            printf("%s: not sorted\n", name);
+            exit(1);
+        }
+    printf("%-10s %8d | %12lld | %12lld | %10.2f\n", name, n, Heavy::copies - c0, allocs - a0, ms);
+}
+
+int main(int argc, char *argv[])
+{
+    int n = argc > 1 ? atoi(argv[1]) : 4000;
+    printf("=== List<Heavy> sort, random keys ===\n");
+    printf("%-10s %8s | %12s | %12s | %10s\n", "algorithm", "n", "copies", "allocs", "ms");
+    run("insertion", n, [](SortableList &L, int n) { L.insertionSort(L.first(), n); });
+    run("selection", n, [](SortableList &L, int n) { L.selectionSort(L.first(), n); });
+    run("merge", n * 100, [](SortableList &L, int n) { ListNodePosi(Heavy) p = L.first(); L.mergeSort(p, n); });
+    run("natural", n * 100, [](SortableList &L, int n) { ListNodePosi(Heavy) p = L.first(); L.naturalMergeSort(p, n); });
+
+    int m = n * 250;
+    printf("\n=== List<int> sort, n = %d, ms ===\n", m);
+    printf("%-14s | %10s | %10s\n", "input", "merge", "natural");
+    for (int order = 0; order < 4; order++)
+        printf("%-14s | %10.2f | %10.2f\n", orderName[order], sortInts(m, order, false), sortInts(m, order, true));
+    return 0;
+}
@@ -0,0 +1,94 @@
+// 线程间传递元素：加锁的Queue与无锁的MPMCQueue、SPSCQueue的对比
+// 编译：g++ -O2 -std=c++17 -pthread bench_mpmc.cpp -o output/bench_mpmc.exe
+#include "queue.h"
+#include "concurrentqueue.h"
+#include "bench.h"
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct LockedQueue // 以互斥锁保护的Queue，即改用无锁队列之前的做法
+{
+    std::mutex m;
+    Queue<long> q;
+    bool enqueue(long e)
+    {
+        std::lock_guard<std::mutex> lk(m);
+        q.enqueue(e);
+        return true;
+    }
+    bool dequeue(long &e)
+    {
+        std::lock_guard<std::mutex> lk(m);
+        if (q.empty())
+            return false;
+        e = q.dequeue();
+        return true;
+    }
+};
+
+struct UnboundedSPSC : SPSCQueue<long> // 统一接口：入队总能成功
+{
+    bool enqueue(long e)
+    {
+        SPSCQueue<long>::enqueue(e);
+        return true;
+    }
+};
+
+template <typename Q>
+double transfer(Q &q, int producers, int consumers, long n) // P个生产者共入队n个元素，C个消费者全部取走；返回ns/元素
+{
+    std::atomic<long> got(0), sum(0);
+    double ms = measureMs([&]() {
+        std::vector<std::thread> th;
+        for (int p = 0; p < producers; p++)
+            th.emplace_back([&, p]() {
+                for (long i = p; i < n; i += producers)
+                    while (!q.enqueue(i))
+                        std::this_thread::yield();
+            });
+        for (int c = 0; c < consumers; c++)
+            th.emplace_back([&]() {
+                long e, local = 0;
+                while (got.load(std::memory_order_relaxed) < n)
+                    if (q.dequeue(e))
+                        local += e, got.fetch_add(1, std::memory_order_relaxed);
+                    else
+                        std::this_thread::yield();
+                sum += local;
+            });
+        for (std::thread &t : th)
+            t.join();
+    });
+    if (sum != n * (n - 1) / 2)
+    {
+        printf("checksum mismatch\n");
+        exit(1);
+    }
+    return ms * 1e6 / n;
+}
+
+int main(int argc, char *argv[])
+{
+    long n = argc > 1 ? atol(argv[1]) : 2000000;
+    printf("=== %ld elements between threads (%u hardware threads), ns per element ===\n", n, std::thread::hardware_concurrency());
+    printf("%-10s | %12s | %12s | %12s\n", "P x C", "mutex Queue", "MPMCQueue", "SPSCQueue");
+    int counts[] = {1, 2, 4, 8, 16, 32};
+    for (int t : counts)
+    {
+        LockedQueue locked;
+        MPMCQueue<long> mpmc(1024);
+        printf("%3d x %-4d | %12.2f | %12.2f", t, t, transfer(locked, t, t, n), transfer(mpmc, t, t, n));
+        if (t == 1)
+        {
+            UnboundedSPSC spsc;
+            printf(" | %12.2f\n", transfer(spsc, 1, 1, n));
+        }
+        else
+            printf(" | %12s\n", "-");
+    }
+    return 0;
+}
@@ -0,0 +1,44 @@
+// parallel_sort在不同线程数下的耗时与加速比
+// 编译：g++ -O2 -std=c++17 -pthread bench_parallel_sort.cpp -o output/bench_parallel_sort.exe
+// 用法：bench_parallel_sort [规模，默认10000000] [最大线程数，默认为硬件线程数]
+#include "vector_parallel.h"
+#include "bench.h"
+#include <cstdio>
+#include <cstdlib>
+
+int main(int argc, char *argv[])
+{
+    int n = argc > 1 ? atoi(argv[1]) : 10000000;
+    int maxThreads = argc > 2 ? atoi(argv[2]) : (int)std::thread::hardware_concurrency();
+    if (maxThreads < 1)
+        maxThreads = 1;
+    printf("=== parallel_sort(Vector<int>), n = %d random ints (ms, speedup) ===\n", n);
+    printf("%8s | %16s | %16s |\n", "threads", "merge", "quick");
+    SortStrategy strategy[2] = {SORT_MERGE, SORT_QUICK};
+    double base[2];
+    Vector<int> ref[2];
+    for (int s = 0; s < 2; s++) // 串行结果与耗时作为基准
+    {
+        fillInput(ref[s], n, INPUT_RANDOM);
+        base[s] = measureMs([&]() { ref[s].sort(0, n, strategy[s]); });
+    }
+    printf("%8s | %9.1f %6s | %9.1f %6s |\n", "seq", base[0], "1.00x", base[1], "1.00x");
+    for (int t = 1;; t = (t * 2 < maxThreads) ? t * 2 : maxThreads)
+    {
+        printf("%8d |", t);
+        for (int s = 0; s < 2; s++)
+        {
+            Vector<int> v;
+            fillInput(v, n, INPUT_RANDOM);
+            double ms = measureMs([&]() { parallel_sort(v, t, strategy[s]); });
+            bool same = true;
+            for (int i = 0; i < n && same; i++)
+                same = (v[i] == ref[s][i]);
+            printf(" %9.1f %5.2fx%s|", ms, base[s] / ms, same ? " " : "!");
+        }
+        printf("\n");
+        if (t == maxThreads)
+            break;
+    }
+    return 0;
+}
@@ -0,0 +1,94 @@
+// Queue<T>的入队/出队往复：节点池与全局new/delete的对比，以及节点在一个线程中分配、在另一线程中释放的情形
+// 编译：g++ -O2 -std=c++17 -pthread bench_queue.cpp -o output/bench_queue.exe
+//      g++ -O2 -std=c++17 -pthread -DLIST_NODE_POOL=0 bench_queue.cpp -o output/bench_queue_malloc.exe
+#include "queue.h"
+#include "bench.h"
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <thread>
+#if defined(__unix__)
+#include <sys/resource.h>
+#endif
+
+static long peakRssMB() // 进程的峰值常驻内存；非Unix平台返回-1
+{
+#if defined(__unix__)
+    struct rusage r;
+    getrusage(RUSAGE_SELF, &r);
+    return r.ru_maxrss / 1024;
+#else
+    return -1;
+#endif
+}
+
+void crossThread(int depth, int rounds) // 生产者入队、消费者出队，经互斥锁保护的Queue传递，队中至多depth个元素
+{ // 节点均由生产者分配、由消费者释放；池若不把节点还给生产者，内存将随rounds线性增长
+    std::mutex m;
+    Queue<int> q;
+    long long sum = 0;
+    double ms = measureMs([&]() {
+        std::thread producer([&]() {
+            for (int i = 0; i < rounds;)
+            {
+                {
+                    std::lock_guard<std::mutex> lk(m);
+                    if (q.size() < depth)
+                    {
+                        q.enqueue(i++);
+                        continue;
+                    }
+                }
+                std::this_thread::yield();
+            }
+        });
+        for (int got = 0; got < rounds;)
+        {
+            {
+                std::lock_guard<std::mutex> lk(m);
+                if (!q.empty())
+                {
+                    sum += q.dequeue();
+                    got++;
+                    continue;
+                }
+            }
+            std::this_thread::yield();
+        }
+        producer.join();
+    });
+    printf("%-8s %8d | %10.2f | %10.2f | peak RSS %ld MB   (%lld)\n", "x-thread", depth, ms, ms * 1e6 / rounds, peakRssMB(), sum);
+}
+
+template <typename T, typename Make>
+void churn(const char *name, int depth, int rounds, Make make)
+{
+    Queue<T> q;
+    for (int i = 0; i < depth; i++)
+        q.enqueue(make(i));
+    double ms = measureMs([&]() {
+        for (int i = 0; i < rounds; i++)
+        {
+            q.enqueue(make(i));
+            q.dequeue();
+        }
+    });
+    long long sum = 0;
+    double scan = measureMs([&]() { for (ListNodePosi(T) p = q.first(); p != q.last()->succ; p = p->succ) sum += sizeof(p->data); });
+    printf("%-8s %8d | %10.2f | %10.2f | %12.2f   (%lld)\n", name, depth, ms, ms * 1e6 / rounds, scan, sum);
+}
+
+int main(int argc, char *argv[])
+{
+    int rounds = argc > 1 ? atoi(argv[1]) : 10000000;
+    printf("=== Queue churn: %d enqueue + dequeue pairs, node pool %s ===\n", rounds, LIST_NODE_POOL ? "on" : "off");
+    printf("%-8s %8s | %10s | %10s | %12s\n", "type", "depth", "ms", "ns/pair", "scan ms");
+    crossThread(1000, rounds); // 先于其它用例运行，峰值内存只反映此用例
+    int depths[] = {16, 1000, 1000000};
+    for (int d : depths)
+        churn<int>("int", d, rounds, [](int i) { return i; });
+    for (int d : depths)
+        churn<std::string>("string", d, rounds / 4, [](int i) { return std::string(i & 7, 'x'); });
+    return 0;
+}
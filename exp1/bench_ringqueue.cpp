@@ -0,0 +1,73 @@
+// 环形缓冲区队列RingQueue与基于List的Queue的吞吐量对比
+// 编译：g++ -O2 -std=c++17 bench_ringqueue.cpp -o output/bench_ringqueue.exe
+#include "queue.h"
+#include "ringqueue.h"
+#include "bench.h"
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+static long long weigh(int e) { return e; } // 使出队结果参与计算，以免被优化掉
+static long long weigh(std::string const &e) { return (long long)e.size(); }
+
+template <typename Q, typename Make>
+void churn(const char *name, int depth, int rounds, Make make) // 维持深度depth，往复入队、出队
+{
+    Q q;
+    for (int i = 0; i < depth; i++)
+        q.enqueue(make(i));
+    long long sum = 0;
+    double ms = measureMs([&]() {
+        for (int i = 0; i < rounds; i++)
+        {
+            q.enqueue(make(i));
+            sum += weigh(q.dequeue());
+        }
+    });
+    printf("%-22s %-6s %9d | %10.2f", name, "churn", depth, ms * 1e6 / rounds);
+    printf("   (%lld)\n", sum);
+}
+
+template <typename Q, typename Make>
+void burst(const char *name, int n, int rounds, Make make) // 先连续入队n个，再全部出队
+{
+    Q q;
+    long long sum = 0;
+    double ms = measureMs([&]() {
+        for (int r = 0; r < rounds / n; r++)
+        {
+            for (int i = 0; i < n; i++)
+                q.enqueue(make(i));
+            while (!q.empty())
+                sum += weigh(q.dequeue());
+        }
+    });
+    printf("%-22s %-6s %9d | %10.2f", name, "burst", n, ms * 1e6 / (rounds / n * n));
+    printf("   (%lld)\n", sum);
+}
+
+int main(int argc, char *argv[])
+{
+    int rounds = argc > 1 ? atoi(argv[1]) : 10000000;
+    printf("=== Queue vs RingQueue: ns per enqueue + dequeue pair ===\n");
+    printf("%-22s %-6s %9s | %10s\n", "queue", "mode", "depth", "ns/pair");
+    auto mkInt = [](int i) { return i; };
+    auto mkStr = [](int i) { return std::string(i & 7, 'x'); };
+    int depths[] = {16, 1000, 1000000};
+    for (int d : depths)
+    {
+        churn<Queue<int>>("Queue<int>", d, rounds, mkInt);
+        churn<RingQueue<int>>("RingQueue<int>", d, rounds, mkInt);
+    }
+    for (int d : depths)
+    {
+        burst<Queue<int>>("Queue<int>", d, rounds, mkInt);
+        burst<RingQueue<int>>("RingQueue<int>", d, rounds, mkInt);
+    }
+    for (int d : depths)
+    {
+        churn<Queue<std::string>>("Queue<string>", d, rounds / 4, mkStr);
+        churn<RingQueue<std::string>>("RingQueue<string>", d, rounds / 4, mkStr);
+    }
+    return 0;
+}
@@ -0,0 +1,41 @@
+// 有序向量各查找算法的平均单次耗时对比
+// 编译：g++ -O2 -std=c++17 bench_search.cpp -o output/bench_search.exe
+// 用法：bench_search [最大规模，默认100000000]
+#include "vector.h"
+#include "eytzinger.h"
+#include "bench.h"
+#include <cstdio>
+#include <cstdlib>
+
+#define N_QUERY 1000000
+
+int main(int argc, char *argv[])
+{
+    long long maxN = argc > 1 ? atoll(argv[1]) : 100000000;
+    std::mt19937 g(2025);
+    printf("=== sorted Vector<int> search, %d random queries (ns/query) ===\n", N_QUERY);
+    printf("%10s | %9s | %9s | %10s | %9s | %11s |\n", "n", "binSearch", "fibSearch", "branchless", "eytzinger", "search_many");
+    for (long long n = 1000; n <= maxN; n *= 10)
+    {
+        Vector<int> v;
+        v.reserve((Rank)n);
+        for (Rank i = 0; i < n; i++)
+            v.emplace_back(2 * i); // 奇数键查找失败，偶数键查找成功
+        Vector<int> keys(N_QUERY);
+        for (int i = 0; i < N_QUERY; i++)
+            keys.emplace_back((int)(g() % (2 * n)));
+        Eytzinger<int> ez(v);
+        long long sum[5] = {0, 0, 0, 0, 0}; // 累加查找结果，防止被优化掉
+        double ms[5];
+        ms[0] = measureMs([&]() { for (int i = 0; i < N_QUERY; i++) sum[0] += binSearch(&v[0], keys[i], 0, v.size()); });
+        ms[1] = measureMs([&]() { for (int i = 0; i < N_QUERY; i++) sum[1] += fibSearch(&v[0], keys[i], 0, v.size()); });
+        ms[2] = measureMs([&]() { for (int i = 0; i < N_QUERY; i++) sum[2] += v.searchBranchless(keys[i]); });
+        ms[3] = measureMs([&]() { for (int i = 0; i < N_QUERY; i++) sum[3] += ez.search(keys[i]); });
+        ms[4] = measureMs([&]() { Vector<Rank> R = v.search_many(keys); for (int i = 0; i < N_QUERY; i++) sum[4] += R[i]; });
+        if (sum[0] != sum[2] || sum[0] != sum[3] || sum[0] != sum[4] || sum[1] == 0)
+            printf("MISMATCH!\n");
+        printf("%10lld | %9.1f | %9.1f | %10.1f | %9.1f | %11.1f |\n", n,
+               ms[0] * 1e6 / N_QUERY, ms[1] * 1e6 / N_QUERY, ms[2] * 1e6 / N_QUERY, ms[3] * 1e6 / N_QUERY, ms[4] * 1e6 / N_QUERY);
+    }
+    return 0;
+}
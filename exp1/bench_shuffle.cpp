@@ -0,0 +1,30 @@
+// 置乱的耗时：rand() % i（原unsort）、Xoshiro256 + Lemire、std::shuffle + mt19937、分桶并行置乱
+// 编译：g++ -O2 -std=c++17 -pthread bench_shuffle.cpp -o output/bench_shuffle.exe
+#include "vector_parallel.h"
+#include "bench.h"
+#include <cstdio>
+#include <cstdlib>
+
+template <typename T>
+static void randUnsort(Vector<T> &v) // 原实现：有偏，且rand()不可重入
+{
+    for (Rank i = v.size(); i > 0; i--)
+        swap(v[i - 1], v[rand() % i]);
+}
+
+int main(int argc, char *argv[])
+{
+    int n = argc > 1 ? atoi(argv[1]) : 10000000;
+    int threads = argc > 2 ? atoi(argv[2]) : (int)thread::hardware_concurrency();
+    printf("=== shuffle %d ints (ms), parallel_unsort with %d threads ===\n", n, threads);
+    Vector<int> v;
+    for (int i = 0; i < n; i++)
+        v.insert(i);
+    Xoshiro256 g(2025);
+    std::mt19937 mt(2025);
+    printf("%-28s %10.2f\n", "rand() % i", measureMs([&]() { randUnsort(v); }));
+    printf("%-28s %10.2f\n", "std::shuffle, mt19937", measureMs([&]() { std::shuffle(v.begin(), v.end(), mt); }));
+    printf("%-28s %10.2f\n", "unsort(Xoshiro256)", measureMs([&]() { v.unsort(g); }));
+    printf("%-28s %10.2f\n", "parallel_unsort(Xoshiro256)", measureMs([&]() { parallel_unsort(v, g, threads); }));
+    return 0;
+}
@@ -0,0 +1,48 @@
+// find、disordered、uniquify所用扫描的SIMD版本与通用模板的耗时对比（uniquify另含析构与shrink，不计入）
+// 编译：g++ -O2 -std=c++17 bench_simd.cpp -o output/bench_simd.exe
+#include "vector.h"
+#include "bench.h"
+#include <cstdio>
+#include <cstdlib>
+
+#define N_REPEAT 20
+
+template <typename T>
+void run(const char *name, int n)
+{
+    Vector<T> v(n);
+    for (int i = 0; i < n; i++)
+        v.emplace_back((T)(i / 4)); // 有序，每个值重复4次
+    T missing = (T)-1;
+    T *A = &v[0];
+    Rank sink = 0;
+    double ms[6];
+    ms[0] = measureMs([&]() { for (int r = 0; r < N_REPEAT; r++) sink += findLast<T>(A, missing, 0, n); });
+    ms[1] = measureMs([&]() { for (int r = 0; r < N_REPEAT; r++) sink += findLast(A, missing, 0, n); });
+    ms[2] = measureMs([&]() { for (int r = 0; r < N_REPEAT; r++) sink += countDescents<T>(A, n); });
+    ms[3] = measureMs([&]() { for (int r = 0; r < N_REPEAT; r++) sink += countDescents(A, n); });
+    ms[4] = ms[5] = 0;
+    for (int r = 0; r < N_REPEAT; r++) // uniquify会改动向量，每轮在副本上进行（复制不计时）
+    {
+        Vector<T> u(v), w(v);
+        ms[4] += measureMs([&]() { sink += compactRuns<T>(&u[0], n); });
+        ms[5] += measureMs([&]() { sink += compactRuns(&w[0], n); });
+    }
+    printf("%-8s| %8.2f %8.2f %5.1fx | %8.2f %8.2f %5.1fx | %8.2f %8.2f %5.1fx | %lld\n", name,
+           ms[0] / N_REPEAT, ms[1] / N_REPEAT, ms[0] / ms[1], ms[2] / N_REPEAT, ms[3] / N_REPEAT, ms[2] / ms[3],
+           ms[4] / N_REPEAT, ms[5] / N_REPEAT, ms[4] / ms[5], (long long)sink);
+}
+
+int main(int argc, char *argv[])
+{
+    int n = argc > 1 ? atoi(argv[1]) : 10000000;
+#ifdef VECTOR_SIMD
+    printf("SIMD level: %s\n", simdLevel() == 2 ? "AVX2" : simdLevel() == 1 ? "SSE2" : "none");
+#endif
+    printf("=== n = %d, ms per call: generic template / dispatched overload / speedup ===\n", n);
+    printf("%-8s| %24s | %24s | %24s |\n", "type", "find (miss)", "disordered", "uniquify");
+    run<int>("int", n);
+    run<float>("float", n);
+    run<double>("double", n);
+    return 0;
+}
@@ -0,0 +1,42 @@
+// 各排序策略在不同输入下的耗时对比
+// 编译：g++ -O2 -std=c++17 bench_sort.cpp -o output/bench_sort.exe
+#include "vector.h"
+#include "bench.h"
+#include <cstdio>
+#include <cstdlib>
+
+static const char *strategyName[] = {"intro", "bubble", "selection", "merge", "heap", "quick", "merge-bu"};
+
+int main(int argc, char *argv[])
+{
+    int sizes[] = {10000, argc > 1 ? atoi(argv[1]) : 1000000};
+    for (int n : sizes)
+    {
+        printf("\n=== Vector<int>::sort, n = %d (ms) ===\n", n);
+        printf("%-10s|", "strategy");
+        for (int k = 0; k < 4; k++)
+            printf(" %10s |", inputName[k]);
+        printf("\n");
+        for (int s = 0; s < 7; s++)
+        {
+            printf("%-10s|", strategyName[s]);
+            for (int k = 0; k < 4; k++)
+            {
+                if (50000 < n && (s == SORT_BUBBLE || s == SORT_SELECTION)) // O(n^2)算法只测小规模
+                {
+                    printf(" %10s |", "-");
+                    continue;
+                }
+                Vector<int> v;
+                fillInput(v, n, (InputKind)k);
+                double ms = measureMs([&]() { v.sort(0, v.size(), (SortStrategy)s); });
+                if (v.disordered())
+                    printf("  UNSORTED! |");
+                else
+                    printf(" %10.2f |", ms);
+            }
+            printf("\n");
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,82 @@
+// Stack（基于Vector）与FastStack的对比：深浅交替的压栈、出栈，以及evaluate()的运算数栈、运算符栈
+// 编译：g++ -O2 -std=c++17 bench_stack.cpp -o output/bench_stack.exe
+#include "stack.h"
+#include "faststack.h"
+#include "bench.h"
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+template <typename S>
+double oscillate(int depth, int cycles, long long &sum) // 每轮压入depth个元素再全部弹出
+{
+    S s;
+    return measureMs([&]() {
+        for (int c = 0; c < cycles; c++)
+        {
+            for (int i = 0; i < depth; i++)
+                s.push(i);
+            while (!s.empty())
+                sum += s.pop();
+        }
+    });
+}
+
+long long stackReallocs(int depth, int cycles) // Stack在上述过程中的重分配次数
+{
+    Stack<int> s;
+    for (int c = 0; c < cycles; c++)
+    {
+        for (int i = 0; i < depth; i++)
+            s.push(i);
+        while (!s.empty())
+            s.pop();
+    }
+    return s.memory_stats().reallocations;
+}
+
+template <typename Opnd, typename Optr>
+double evaluateMany(std::string const &expr, int times, float &result)
+{
+    std::string buf(expr);
+    return measureMs([&]() {
+        for (int t = 0; t < times; t++)
+        {
+            char *rpn = (char *)malloc(1);
+            *rpn = '\0';
+            result += evaluate<Opnd, Optr>(&buf[0], rpn);
+            free(rpn);
+        }
+    });
+}
+
+int main(int argc, char *argv[])
+{
+    int total = argc > 1 ? atoi(argv[1]) : 20000000; // 每种深度压栈、出栈的总次数
+    long long sum = 0;
+    printf("=== push/pop oscillation, %d pushes per row ===\n", total);
+    printf("%9s | %12s | %12s | %12s\n", "depth", "Stack ms", "reallocs", "FastStack ms");
+    int depths[] = {8, 100, 1000, 100000};
+    for (int d : depths)
+    {
+        double a = oscillate<Stack<int>>(d, total / d, sum);
+        long long r = stackReallocs(d, total / d);
+        double b = oscillate<FastStack<int>>(d, total / d, sum);
+        printf("%9d | %12.2f | %12lld | %12.2f\n", d, a, r, b);
+    }
+
+    std::string expr = "1"; // 嵌套的括号使两个栈都达到一定深度
+    for (int i = 0; i < 40; i++)
+        expr = "(" + expr + "+2*(3-1)^2)";
+    int times = 20000;
+    float r1 = 0, r2 = 0;
+    double a = 0, b = 0;
+    for (int k = 0; k < 3; k++) // 交替测量三轮，减小先后次序的影响
+    {
+        a += evaluateMany<Stack<float>, Stack<char>>(expr, times, r1);
+        b += evaluateMany<FastStack<float>, FastStack<char>>(expr, times, r2);
+    }
+    printf("\n=== evaluate(), %d-character expression x %d x 3 ===\n", (int)expr.size(), times);
+    printf("Stack: %.2f ms, FastStack: %.2f ms   (%g %g %lld)\n", a, b, r1, r2, sum);
+    return 0;
+}
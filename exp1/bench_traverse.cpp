@@ -0,0 +1,33 @@
+// traverse的几种调用方式：函数指针、函数对象（可内联）、并行遍历
+// 编译：g++ -O2 -std=c++17 -pthread bench_traverse.cpp -o output/bench_traverse.exe
+#include "vector_parallel.h"
+#include "bench.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+#define N_REPEAT 10
+
+static void increaseOne(int &e) { e++; }
+static void scaleOne(double &e) { e = std::sqrt(e * e + 1.0); }
+
+int main(int argc, char *argv[])
+{
+    int n = argc > 1 ? atoi(argv[1]) : 10000000;
+    int threads = argc > 2 ? atoi(argv[2]) : (int)thread::hardware_concurrency();
+    printf("=== traverse over %d elements, ms per pass, %d threads for parallel_traverse ===\n", n, threads);
+    printf("%-12s | %14s | %14s | %14s\n", "visit", "function ptr", "functor", "parallel");
+
+    Vector<int> a(n, n, 0);
+    double t0 = measureMs([&]() { for (int r = 0; r < N_REPEAT; r++) a.traverse(increaseOne); });
+    double t1 = measureMs([&]() { for (int r = 0; r < N_REPEAT; r++) a.traverse(Increase<int>()); });
+    double t2 = measureMs([&]() { for (int r = 0; r < N_REPEAT; r++) parallel_traverse(a, Increase<int>(), PARALLEL_TRAVERSE_GRAIN, threads); });
+    printf("%-12s | %14.2f | %14.2f | %14.2f   (check %d)\n", "int e++", t0 / N_REPEAT, t1 / N_REPEAT, t2 / N_REPEAT, a[n / 2]);
+
+    Vector<double> b(n, n, 1.0);
+    t0 = measureMs([&]() { for (int r = 0; r < N_REPEAT; r++) b.traverse(scaleOne); });
+    t1 = measureMs([&]() { for (int r = 0; r < N_REPEAT; r++) b.traverse([](double &e) { e = std::sqrt(e * e + 1.0); }); });
+    t2 = measureMs([&]() { for (int r = 0; r < N_REPEAT; r++) parallel_traverse(b, [](double &e) { e = std::sqrt(e * e + 1.0); }, PARALLEL_TRAVERSE_GRAIN, threads); });
+    printf("%-12s | %14.2f | %14.2f | %14.2f   (check %.3f)\n", "double sqrt", t0 / N_REPEAT, t1 / N_REPEAT, t2 / N_REPEAT, b[n / 2]);
+    return 0;
+}
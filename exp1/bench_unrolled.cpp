@@ -0,0 +1,52 @@
+// 展开链表UnrolledList<int>与List<int>的对比：建表、遍历、队列式首尾进出与排序
+// 编译：g++ -O2 -std=c++17 bench_unrolled.cpp -o output/bench_unrolled.exe
+#include "List.h"
+#include "unrolledlist.h"
+#include "bench.h"
+#include <cstdio>
+#include <cstdlib>
+
+template <typename L, typename Sort>
+void run(const char *name, int n, int rounds, Sort sort)
+{
+    std::mt19937 g(2025);
+    long long sum = 0;
+    {
+        L list;
+        double build = measureMs([&]() { for (int i = 0; i < n; i++) list.insertAsLast(i); });
+        double scan = measureMs([&]() { for (int r = 0; r < 10; r++) list.traverse([&](int &e) { sum += e; }); }) / 10;
+        double churn = measureMs([&]() {
+            for (int i = 0; i < rounds; i++)
+            {
+                list.insertAsLast(i);
+                sum += list.removeFirst();
+            }
+        });
+        printf("%-14s %9d | %10.2f | %10.2f | %12.2f", name, n, build, scan, churn * 1e6 / rounds);
+    }
+    L list;
+    for (int i = 0; i < n; i++)
+        list.insertAsLast((int)(g() >> 1));
+    double ms = measureMs([&]() { sort(list); });
+    printf(" | %10.2f   (%lld)\n", ms, sum);
+}
+
+struct QueueList : List<int>
+{
+    int removeFirst() { return remove(first()); }
+};
+
+int main(int argc, char *argv[])
+{
+    int n = argc > 1 ? atoi(argv[1]) : 1000000;
+    int rounds = 10000000;
+    printf("=== List<int> vs UnrolledList<int> (%d ints per chunk) ===\n", (int)(UNROLLED_CHUNK_BYTES / sizeof(int)));
+    printf("%-14s %9s | %10s | %10s | %12s | %10s\n", "container", "n", "build ms", "scan ms", "ns/push+pop", "sort ms");
+    for (int m = 1000; m <= n; m *= 1000)
+    {
+        run<QueueList>("List", m, rounds, [](QueueList &L) { L.sort(); });
+        run<UnrolledList<int>>("UnrolledList", m, rounds, [](UnrolledList<int> &L) { L.sort(); });
+    }
+    printf("bytes per element: List %d (node), UnrolledList %.2f (full chunk)\n", (int)sizeof(ListNode<int>), (double)sizeof(UnrolledChunk<int, UNROLLED_CHUNK_BYTES / sizeof(int)>) / (UNROLLED_CHUNK_BYTES / sizeof(int)));
+    return 0;
+}
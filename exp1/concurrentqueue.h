@@ -0,0 +1,209 @@
+#ifndef CONCURRENTQUEUE_H
+#define CONCURRENTQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+#define CACHE_LINE 64 // 分属不同线程频繁写入的字段按此对齐，避免伪共享
+#define SPSC_BLOCK 512 // SPSCQueue每块容纳的元素数
+
+// 有界多生产者多消费者无锁队列（Dmitry Vyukov的序号环）
+// 每个槽带一个序号：等于入队位置pos时可写，等于pos + 1时可读，出队后置为pos + 容量以供下一轮使用
+// 生产者、消费者各自以CAS争用一个位置计数器，在槽上无需加锁；满时enqueue、空时dequeue立即返回false
+// 并发环境下“队首元素”随时可能被他人取走，故不提供front()
+template <typename T>
+class MPMCQueue
+{
+private:
+    struct Cell
+    {
+        std::atomic<size_t> seq;
+        alignas(T) unsigned char buf[sizeof(T)];
+        T *data() { return (T *)buf; }
+    };
+    Cell *_cells;
+    size_t _mask;
+    alignas(CACHE_LINE) std::atomic<size_t> _enq;
+    alignas(CACHE_LINE) std::atomic<size_t> _deq; // 对象按CACHE_LINE对齐，其大小亦为其整数倍，故_deq所在的行不与其它对象共享
+
+    Cell *claim(std::atomic<size_t> &counter, size_t ready, size_t &pos) // 争得一个序号为pos + ready的槽；无可用槽时返回NULL
+    {
+        pos = counter.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            Cell *c = _cells + (pos & _mask);
+            intptr_t d = (intptr_t)c->seq.load(std::memory_order_acquire) - (intptr_t)(pos + ready);
+            if (d == 0)
+            {
+                if (counter.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    return c;
+            }
+            else if (d < 0)
+                return NULL;
+            else
+                pos = counter.load(std::memory_order_relaxed);
+        }
+    }
+
+public:
+    explicit MPMCQueue(size_t capacity) : _enq(0), _deq(0) // 容量向上取整为2的幂，至少为2
+    {
+        size_t n = 2;
+        while (n < capacity)
+            n *= 2;
+        _mask = n - 1;
+        _cells = (Cell *)::operator new(n * sizeof(Cell));
+        for (size_t i = 0; i < n; i++)
+            new (&_cells[i].seq) std::atomic<size_t>(i);
+    }
+    MPMCQueue(MPMCQueue const &) = delete;
+    MPMCQueue &operator=(MPMCQueue const &) = delete;
+    ~MPMCQueue()
+    {
+        for (size_t pos = _deq; pos != _enq; pos++)
+            _cells[pos & _mask].data()->~T();
+        ::operator delete((void *)_cells);
+    }
+
+    size_t capacity() const { return _mask + 1; }
+    size_t size() const // 近似值：其它线程可能正在入队、出队
+    {
+        size_t enq = _enq.load(std::memory_order_relaxed), deq = _deq.load(std::memory_order_relaxed);
+        return enq < deq ? 0 : enq - deq;
+    }
+    bool empty() const { return size() == 0; }
+
+    template <typename... Args>
+    bool emplace(Args &&...args)
+    {
+        size_t pos;
+        Cell *c = claim(_enq, 0, pos);
+        if (!c)
+            return false;
+        new (c->data()) T(std::forward<Args>(args)...);
+        c->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+    bool enqueue(T const &e) { return emplace(e); }
+    bool enqueue(T &&e) { return emplace(std::move(e)); }
+    bool dequeue(T &e)
+    {
+        size_t pos;
+        Cell *c = claim(_deq, 1, pos);
+        if (!c)
+            return false;
+        e = std::move(*c->data());
+        c->data()->~T();
+        c->seq.store(pos + _mask + 1, std::memory_order_release);
+        return true;
+    }
+};
+
+// 无界单生产者单消费者队列：元素存放于由B个槽组成的块链中
+// 生产者写入元素后以release发布已写总数，消费者以acquire读取，此外无需任何原子读改写
+// 消费者读空的块留作备用，供生产者下次换块时取用，稳定状态下不访问堆
+// enqueue、emplace只能由生产者调用；dequeue、front只能由消费者调用
+template <typename T, int B = SPSC_BLOCK>
+class SPSCQueue
+{
+private:
+    struct Block
+    {
+        alignas(T) unsigned char buf[B * sizeof(T)];
+        Block *next; // 生产者在发布新块中的首个元素之前写入，消费者在读到该元素之后才访问
+        T *data() { return (T *)buf; }
+    };
+    // 生产者独占
+    alignas(CACHE_LINE) Block *_tail;
+    int _tailIdx;
+    size_t _written;
+    // 消费者独占
+    alignas(CACHE_LINE) Block *_head;
+    int _headIdx;
+    size_t _read;
+    size_t _writtenSeen; // 最近一次读到的_published，在其耗尽之前不必再读共享计数器
+    // 共享
+    alignas(CACHE_LINE) std::atomic<size_t> _published; // 已发布的元素总数
+    alignas(CACHE_LINE) std::atomic<size_t> _consumed;  // 已取走的元素总数，仅供size()
+    std::atomic<Block *> _spare;
+
+public:
+    SPSCQueue() : _tailIdx(0), _written(0), _headIdx(0), _read(0), _writtenSeen(0), _published(0), _consumed(0), _spare(NULL)
+    {
+        _head = _tail = new Block;
+        _tail->next = NULL;
+    }
+    SPSCQueue(SPSCQueue const &) = delete;
+    SPSCQueue &operator=(SPSCQueue const &) = delete;
+    ~SPSCQueue()
+    {
+        for (; _read < _written; _read++)
+        {
+            if (_headIdx == B)
+            {
+                Block *b = _head;
+                _head = b->next;
+                _headIdx = 0;
+                delete b;
+            }
+            _head->data()[_headIdx++].~T();
+        }
+        delete _head;
+        delete _spare.load();
+    }
+
+    size_t size() const // 近似值：另一方可能正在操作
+    {
+        size_t w = _published.load(std::memory_order_relaxed), r = _consumed.load(std::memory_order_relaxed);
+        return w < r ? 0 : w - r;
+    }
+    bool empty() const { return size() == 0; }
+
+    template <typename... Args>
+    void emplace(Args &&...args)
+    {
+        if (_tailIdx == B)
+        {
+            Block *b = _spare.exchange(NULL, std::memory_order_acquire);
+            if (!b)
+                b = new Block;
+            b->next = NULL;
+            _tail->next = b;
+            _tail = b;
+            _tailIdx = 0;
+        }
+        new (_tail->data() + _tailIdx++) T(std::forward<Args>(args)...);
+        _published.store(++_written, std::memory_order_release);
+    }
+    void enqueue(T const &e) { emplace(e); }
+    void enqueue(T &&e) { emplace(std::move(e)); }
+    T *front() // 队首元素；队列为空时返回NULL
+    {
+        if (_read == _writtenSeen && _read == (_writtenSeen = _published.load(std::memory_order_acquire)))
+            return NULL;
+        if (_headIdx == B)
+        {
+            Block *b = _head;
+            _head = b->next;
+            _headIdx = 0;
+            delete _spare.exchange(b, std::memory_order_release);
+        }
+        return _head->data() + _headIdx;
+    }
+    bool dequeue(T &e)
+    {
+        T *x = front();
+        if (!x)
+            return false;
+        e = std::move(*x);
+        x->~T();
+        _headIdx++;
+        _consumed.store(++_read, std::memory_order_relaxed);
+        return true;
+    }
+};
+
+#endif
@@ -0,0 +1,72 @@
+#ifndef EYTZINGER_H
+#define EYTZINGER_H
+
+#include "vector.h"
+
+// 有序向量的Eytzinger（完全二叉树层次序）副本，适用于构建一次、查找多次的场合
+// 查找路径上的元素在内存中自前向后排列；对int等4字节元素，一次预取即可覆盖此后四层的所有候选
+template <typename T>
+class Eytzinger
+{
+private:
+    Rank _n;
+    T *_b;     // _b[1, _n]按层次序存放元素，_b[0]不用
+    Rank *_r;  // _r[k]为_b[k]在原向量中的秩
+    Rank build(T const *A, Rank i, Rank k);
+
+public:
+    template <typename Alloc, typename Growth>
+    Eytzinger(Vector<T, Alloc, Growth> const &V); // V须有序
+    ~Eytzinger()
+    {
+        delete[] _b;
+        delete[] _r;
+    }
+    Rank size() const { return _n; }
+    Rank search(T const &e) const; // 与Vector::search语义相同：返回不大于e的最后一个元素在原向量中的秩
+};
+
+template <typename T>
+template <typename Alloc, typename Growth>
+Eytzinger<T>::Eytzinger(Vector<T, Alloc, Growth> const &V)
+{
+    _n = V.size();
+    _b = new T[_n + 1];
+    _r = new Rank[_n + 1];
+    _r[0] = _n; // 查找越过所有元素时的哨兵
+    build(&V[0], 0, 1);
+}
+
+template <typename T>
+Rank Eytzinger<T>::build(T const *A, Rank i, Rank k) // 中序遍历以k为根的子树，依次填入A[i], A[i + 1], ...
+{
+    if (k <= _n)
+    {
+        i = build(A, i, 2 * k);
+        _r[k] = i;
+        _b[k] = A[i++];
+        i = build(A, i, 2 * k + 1);
+    }
+    return i;
+}
+
+template <typename T>
+Rank Eytzinger<T>::search(T const &e) const
+{
+    Rank k = 1;
+    while (k <= _n)
+    {
+        PREFETCH(_b + 16 * k);
+        k = 2 * k + !(e < _b[k]);
+    }
+#if defined(__GNUC__)
+    k >>= __builtin_ffsll(~(long long)k); // 回溯至最后一次向左转的节点，即首个大于e的元素
+#else
+    while (k & 1)
+        k >>= 1;
+    k >>= 1;
+#endif
+    return _r[k] - 1;
+}
+
+#endif
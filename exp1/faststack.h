@@ -0,0 +1,142 @@
+#ifndef FASTSTACK_H
+#define FASTSTACK_H
+
+#include "vector.h"
+
+#define STACK_INLINE 16 // FastStack默认内嵌的元素数
+
+// 连续存储的栈：前N个元素存放于对象内部的缓冲区，超出后转至堆上并按两倍扩容
+// 出栈从不缩容，深浅交替的压栈、出栈不会反复重分配；需要归还空间时显式调用shrink_to_fit()
+// push、pop、top只涉及栈顶，均为分摊O(1)
+template <typename T, int N = STACK_INLINE>
+class FastStack
+{
+    static_assert(N > 0, "FastStack needs a non-empty inline buffer"); // 扩容按容量加倍，N为0时将永远为0
+private:
+    T *_elem;
+    Rank _size, _capacity;
+    alignas(T) unsigned char _buf[N * sizeof(T)];
+
+    T *inlineBuf() { return (T *)_buf; }
+    bool onHeap() const { return _elem != (T const *)_buf; }
+    void release()
+    {
+        if (onHeap())
+            allocator<T>().deallocate(_elem, _capacity);
+    }
+    void reallocate(Rank c) // 迁至容量为c（c不小于规模）的空间；c不超过N时回到内嵌缓冲区
+    {
+        T *elem = (c <= N) ? inlineBuf() : allocator<T>().allocate(c);
+        if (elem == _elem)
+            return;
+        relocate(elem, _elem, _size);
+        release();
+        _elem = elem;
+        _capacity = (c <= N) ? N : c;
+    }
+    template <typename... Args>
+    T &growAndEmplace(Args &&...args) // 栈满：先在新空间中构造新元素，参数引用栈中元素时也安全
+    {
+        Rank c = _capacity << 1;
+        T *elem = allocator<T>().allocate(c);
+        new (elem + _size) T(std::forward<Args>(args)...);
+        relocate(elem, _elem, _size);
+        release();
+        _elem = elem;
+        _capacity = c;
+        return _elem[_size++];
+    }
+
+public:
+    typedef T value_type;
+
+    FastStack() : _elem(inlineBuf()), _size(0), _capacity(N) {}
+    FastStack(FastStack const &S) : FastStack()
+    {
+        reserve(S._size);
+        for (Rank i = 0; i < S._size; i++)
+            new (_elem + i) T(S._elem[i]);
+        _size = S._size;
+    }
+    FastStack(FastStack &&S) : FastStack() { *this = std::move(S); }
+    FastStack &operator=(FastStack const &S)
+    {
+        if (this != &S)
+        {
+            clear();
+            reserve(S._size);
+            for (Rank i = 0; i < S._size; i++)
+                new (_elem + i) T(S._elem[i]);
+            _size = S._size;
+        }
+        return *this;
+    }
+    FastStack &operator=(FastStack &&S) // 对方在堆上时直接接管其空间，否则逐个迁移内嵌的元素
+    {
+        if (this == &S)
+            return *this;
+        clear();
+        if (S.onHeap())
+        {
+            release();
+            _elem = S._elem;
+            _capacity = S._capacity;
+            S._elem = S.inlineBuf();
+            S._capacity = N;
+        }
+        else
+        {
+            relocate(_elem, S._elem, S._size);
+        }
+        _size = S._size;
+        S._size = 0;
+        return *this;
+    }
+    ~FastStack()
+    {
+        clear();
+        release();
+    }
+
+    Rank size() const { return _size; }
+    bool empty() const { return _size <= 0; }
+    Rank capacity() const { return _capacity; }
+    void push(T const &e) { emplace(e); }
+    void push(T &&e) { emplace(std::move(e)); }
+    template <typename... Args>
+    T &emplace(Args &&...args) // 在栈顶就地构造
+    {
+        if (_size == _capacity)
+            return growAndEmplace(std::forward<Args>(args)...);
+        new (_elem + _size) T(std::forward<Args>(args)...);
+        return _elem[_size++];
+    }
+    T pop()
+    {
+        T e = std::move(_elem[--_size]);
+        _elem[_size].~T();
+        return e;
+    }
+    T &top() { return _elem[_size - 1]; }
+    T const &top() const { return _elem[_size - 1]; }
+    T &operator[](Rank r) { return _elem[r]; } // 自栈底起计
+    void clear() // 析构全部元素，保留空间
+    {
+        if (!is_trivially_destructible<T>::value)
+            for (Rank i = 0; i < _size; i++)
+                _elem[i].~T();
+        _size = 0;
+    }
+    void reserve(Rank c)
+    {
+        if (_capacity < c)
+            reallocate(c);
+    }
+    void shrink_to_fit() // 唯一缩容的途径：规模不超过N时回到内嵌缓冲区，否则缩至恰好容纳
+    {
+        if (onHeap() && _size < _capacity)
+            reallocate(_size);
+    }
+};
+
+#endif
@@ -1,26 +1,26 @@
 class Fib
 {
 private:
-    int f, g; // f = fib(k - 1), g = fib(k)。均为int型，很快就会数值溢出
+    long long f, g; // f = fib(k - 1), g = fib(k)。取64位，以覆盖64位的秩
 public:
-    Fib(int n) // 初始化为不小于n的最小Fibonacci项
+    Fib(long long n) // 初始化为不小于n的最小Fibonacci项
     {
         f = 1;
         g = 0;
         while (g < n)
             next();
     }
-    int get()
+    long long get()
     {
         return g; // 获取当前Fibonacci项，O(1)时间
     }
-    int next()
+    long long next()
     {
         g += f;
         f = g - f;
         return g; // 转至下一Fibonacci项，O(1)时间
     }
-    int prev()
+    long long prev()
     {
         f = g - f;
         g -= f;
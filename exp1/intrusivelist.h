@@ -0,0 +1,230 @@
+#ifndef INTRUSIVELIST_H
+#define INTRUSIVELIST_H
+
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include "listsort.h"
+#include "rank.h"
+
+// 侵入式列表的挂钩：对象继承ListHook<Tag>即可加入IntrusiveList<T, Tag>，同一对象可凭不同的Tag同时位于多个列表中
+// 挂钩只记录位置，复制对象时不随之复制
+template <typename Tag = void>
+struct ListHook
+{
+    ListHook *pred, *succ; // 未加入列表时均为NULL
+
+    ListHook() : pred(NULL), succ(NULL) {}
+    ListHook(ListHook const &) : pred(NULL), succ(NULL) {}
+    ListHook &operator=(ListHook const &) { return *this; }
+    bool linked() const { return succ != NULL; }
+};
+
+// 侵入式列表的双向迭代器；V为T时可写，为T const时只读
+template <typename T, typename Tag, typename V = T>
+class IntrusiveIterator
+{
+private:
+    ListHook<Tag> *_p;
+
+public:
+    typedef std::bidirectional_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef ptrdiff_t difference_type;
+    typedef V *pointer;
+    typedef V &reference;
+
+    IntrusiveIterator(ListHook<Tag> *p = NULL) : _p(p) {}
+    IntrusiveIterator(IntrusiveIterator<T, Tag> const &i) : _p(i.hook()) {}
+    ListHook<Tag> *hook() const { return _p; }
+    V &operator*() const { return static_cast<V &>(*_p); }
+    V *operator->() const { return &static_cast<V &>(*_p); }
+    IntrusiveIterator &operator++()
+    {
+        _p = _p->succ;
+        return *this;
+    }
+    IntrusiveIterator operator++(int)
+    {
+        IntrusiveIterator i(*this);
+        _p = _p->succ;
+        return i;
+    }
+    IntrusiveIterator &operator--()
+    {
+        _p = _p->pred;
+        return *this;
+    }
+    IntrusiveIterator operator--(int)
+    {
+        IntrusiveIterator i(*this);
+        _p = _p->pred;
+        return i;
+    }
+    bool operator==(IntrusiveIterator const &i) const { return _p == i._p; }
+    bool operator!=(IntrusiveIterator const &i) const { return _p != i._p; }
+};
+
+// 侵入式列表：节点即对象自身所含的挂钩，插入、删除均不分配内存、不复制对象，删除为O(1)
+// 列表不拥有对象：对象须在析构之前自列表中删除，列表析构时只摘除其中的对象
+// 提供与List相同的merge、reverse、uniquify、sort，均只改链接
+template <typename T, typename Tag = void>
+class IntrusiveList
+{
+private:
+    typedef ListHook<Tag> Hook;
+    Rank _size;
+    Hook header, trailer;
+
+    static T &obj(Hook *h) { return static_cast<T &>(*h); }
+    static Hook *hook(T &x) { return static_cast<Hook *>(&x); }
+    static void unlink(Hook *x)
+    {
+        x->pred->succ = x->succ;
+        x->succ->pred = x->pred;
+    }
+    static void linkBefore(Hook *p, Hook *x) // 将（已摘除的）x接入p之前
+    {
+        x->pred = p->pred;
+        x->succ = p;
+        p->pred->succ = x;
+        p->pred = x;
+    }
+    struct HookLess // 比较两挂钩所属的对象，供relinkMerge等使用
+    {
+        bool operator()(Hook *a, Hook *b) const { return obj(a) < obj(b); }
+    };
+
+public:
+    typedef T value_type;
+    typedef IntrusiveIterator<T, Tag> iterator;
+    typedef IntrusiveIterator<T, Tag, T const> const_iterator;
+
+    IntrusiveList() : _size(0)
+    {
+        header.succ = &trailer;
+        trailer.pred = &header;
+    }
+    IntrusiveList(IntrusiveList const &) = delete;
+    IntrusiveList &operator=(IntrusiveList const &) = delete;
+    ~IntrusiveList() { clear(); }
+
+    Rank size() const { return _size; }
+    bool empty() const { return _size <= 0; }
+    T *first() { return _size ? &obj(header.succ) : NULL; }
+    T *last() { return _size ? &obj(trailer.pred) : NULL; }
+    T *succ(T &x) { return hook(x)->succ == &trailer ? NULL : &obj(hook(x)->succ); }
+    T *pred(T &x) { return hook(x)->pred == &header ? NULL : &obj(hook(x)->pred); }
+    iterator begin() { return iterator(header.succ); }
+    iterator end() { return iterator(&trailer); }
+    const_iterator begin() const { return const_iterator(header.succ); }
+    const_iterator end() const { return const_iterator(const_cast<Hook *>(&trailer)); }
+    static bool linked(T const &x) { return static_cast<Hook const &>(x).linked(); } // x是否已在某个（以Tag区分的）列表中
+
+    T &insertAsFirst(T &x)
+    {
+        linkBefore(header.succ, hook(x));
+        _size++;
+        return x;
+    }
+    T &insertAsLast(T &x)
+    {
+        linkBefore(&trailer, hook(x));
+        _size++;
+        return x;
+    }
+    T &insertA(T &p, T &x) // 将未在列表中的x插至p之后
+    {
+        linkBefore(hook(p)->succ, hook(x));
+        _size++;
+        return x;
+    }
+    T &insertB(T &p, T &x) // 将未在列表中的x插至p之前
+    {
+        linkBefore(hook(p), hook(x));
+        _size++;
+        return x;
+    }
+    T &remove(T &x) // 将本列表中的x摘除，O(1)
+    {
+        Hook *h = hook(x);
+        unlink(h);
+        h->pred = h->succ = NULL;
+        _size--;
+        return x;
+    }
+    void moveToFirst(T &x) // 将本列表中的x移至首位，如LRU中的最近访问者
+    {
+        unlink(hook(x));
+        linkBefore(header.succ, hook(x));
+    }
+    void moveToLast(T &x)
+    {
+        unlink(hook(x));
+        linkBefore(&trailer, hook(x));
+    }
+    Rank clear()
+    {
+        Rank oldSize = _size;
+        while (0 < _size)
+            remove(obj(header.succ));
+        return oldSize;
+    }
+
+    void merge(IntrusiveList &L) // 将有序列表L归并入本（有序）列表，L随之为空；与List::merge相同，只改链接，稳定
+    {
+        if (&L == this)
+            return;
+        Hook *p = header.succ;
+        relinkMerge(p, _size, L.header.succ, L._size, HookLess());
+        _size += L._size;
+        L._size = 0;
+    }
+    void sort() // 与List::sort相同的自然归并排序，见listsort.h
+    {
+        Hook *p = header.succ;
+        relinkNaturalMergeSort(p, _size, HookLess());
+    }
+    void reverse();
+    Rank uniquify(); // 有序列表中相邻的重复者只保留首个，其余摘除（对象本身不受影响）
+    template <typename VST>
+    void traverse(VST &&visit)
+    {
+        for (Hook *p = header.succ; p != &trailer; p = p->succ)
+            visit(obj(p));
+    }
+};
+
+template <typename T, typename Tag>
+void IntrusiveList<T, Tag>::reverse() // 对象不可交换，故逐个交换前驱、后继指针
+{
+    if (_size < 2)
+        return;
+    Hook *first = header.succ, *last = trailer.pred;
+    for (Hook *x = first; x != &trailer;)
+    {
+        Hook *next = x->succ;
+        std::swap(x->pred, x->succ);
+        x = next;
+    }
+    header.succ = last;
+    last->pred = &header;
+    trailer.pred = first;
+    first->succ = &trailer;
+}
+
+template <typename T, typename Tag>
+Rank IntrusiveList<T, Tag>::uniquify()
+{
+    if (_size < 2)
+        return 0;
+    Rank oldSize = _size;
+    for (Hook *p = header.succ, *q; (q = p->succ) != &trailer;)
+        if (obj(p) == obj(q))
+            remove(obj(q));
+        else
+            p = q;
+    return oldSize - _size;
+}
+
+#endif
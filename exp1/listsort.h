@@ -0,0 +1,89 @@
+#ifndef LISTSORT_H
+#define LISTSORT_H
+
+#include "rank.h"
+
+// 双向链表上只改链接的归并与自然归并排序，供List与IntrusiveList共用
+// 节点类型N须有指针成员pred、succ，且区间前后均有节点（哨兵）；lt(a, b)比较节点a、b所含的元素，只需<
+
+template <typename N>
+void relinkBefore(N *p, N *x) // 将节点x摘下并接入p之前（x != p）
+{
+    x->pred->succ = x->succ;
+    x->succ->pred = x->pred;
+    x->pred = p->pred;
+    x->succ = p;
+    p->pred->succ = x;
+    p->pred = x;
+}
+
+template <typename N, typename Less>
+void relinkMerge(N *&p, Rank n, N *q, Rank m, Less lt) // 将自q起的m个节点归并入自p起的n个（有序）节点，p随之指向归并后之首；稳定
+{ // 两段可以分属不同的列表，也可以是同一列表中前后相接的两段
+    N *pp = p->pred;
+    while (0 < m)
+    {
+        if ((0 < n) && !lt(q, p))
+        {
+            if (q == (p = p->succ))
+                break;
+            n--;
+        }
+        else
+        {
+            q = q->succ;
+            relinkBefore(p, q->pred);
+            m--;
+        }
+    }
+    p = pp->succ;
+}
+
+template <typename N, typename Less>
+void relinkNaturalMergeSort(N *&p, Rank n, Less lt) // 对自p起的n个节点排序，p随之指向排序后之首；稳定
+{ // 自左向右逐段识别非降段（严格降序段就地翻转），压入段栈；栈顶两段规模相近即归并，最后自顶向下归并全部
+    if (n < 2)
+        return;
+    N *head = p->pred; // 区间之前的节点不参与归并，据之找回区间之首
+    N *lo[64];         // 栈中各段自底向上首尾相接，且规模逐段减半以上，故不超过64段
+    Rank len[64];
+    int top = 0;
+    N *x = p;
+    for (Rank rest = n; 0 < rest;)
+    {
+        Rank m = 1;
+        N *q = x->succ;
+        if (1 < rest && lt(q, x)) // 严格降序：将后续节点逐个移至段首（不含相等元素，翻转不影响稳定性）
+        {
+            while (m < rest && lt(q, x))
+            {
+                N *next = q->succ;
+                relinkBefore(x, q);
+                x = q;
+                q = next;
+                m++;
+            }
+        }
+        else
+            while (m < rest && !lt(q, q->pred))
+                q = q->succ, m++;
+        lo[top] = x;
+        len[top++] = m;
+        rest -= m;
+        x = q;
+        while (1 < top && len[top - 2] <= 2 * len[top - 1])
+        {
+            relinkMerge(lo[top - 2], len[top - 2], lo[top - 1], len[top - 1], lt);
+            len[top - 2] += len[top - 1];
+            top--;
+        }
+    }
+    for (; 1 < top; top--)
+    {
+        relinkMerge(lo[top - 2], len[top - 2], lo[top - 1], len[top - 1], lt);
+        len[top - 2] += len[top - 1];
+    }
+    p = head->succ;
+}
+
+#endif
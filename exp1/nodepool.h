@@ -0,0 +1,141 @@
+#ifndef NODEPOOL_H
+#define NODEPOOL_H
+
+#include <cstddef>
+#include <mutex>
+#include <new>
+
+#define NODE_POOL_SLAB 256 // 每块slab容纳的节点数
+#define NODE_POOL_CAP 1024 // 每个线程每释放这么多个节点，即将其作为一批移交全局；不小于NODE_POOL_SLAB
+
+// 定长节点池：按slab成批申请，释放的节点挂入空闲链表供再次分配；同一slab中的节点在内存中相邻
+// 每个线程各有一个池，分配、释放均无需加锁
+// 节点可能在一个线程中分配、在另一线程中释放（如经加锁的Queue自生产者传给消费者），故释放的节点不能只留在释放者的池中：
+// 每释放NODE_POOL_CAP次，即将此间释放而尚未再分配的节点作为一批挂入全局链表，供耗尽的池（通常正是分配者）整批取回；
+// 每批至多NODE_POOL_CAP个节点（slab本身不超过此数），取回一批也就至多这么多。线程退出时，所余节点亦移交全局。此后（如静态对象析构时）再释放的节点逐个直接挂入全局链表
+// 只有本线程与全局均无空闲节点时才申请新slab，故slab虽在进程结束前不归还系统，其总量只随节点数的峰值、而不随吞吐量增长
+template <size_t Size, size_t Align>
+class NodePool
+{
+private:
+    union Slot
+    {
+        struct
+        {
+            Slot *next;  // 链表中的后继
+            Slot *batch; // 仅对全局链表中每批的首节点有效：下一批的首节点
+        } link;
+        alignas(Align) unsigned char bytes[Size];
+    };
+    static_assert(Align <= alignof(max_align_t), "over-aligned nodes are not supported");
+    static_assert(NODE_POOL_SLAB <= NODE_POOL_CAP, "a fresh slab must fit in one batch");
+    Slot *_free;   // 本线程上次移交以来释放而尚未再分配的节点，不超过_frees个；分配时优先取用，以便复用尚在缓存中的节点
+    Slot *_carry;  // 新slab或自全局取回的一批中尚未分配的节点，_free为空时取用
+    int _frees;    // 上次移交以来的释放次数；只在释放时累加。初值为NODE_POOL_CAP - 1，首次释放即经由spill登记Reaper
+    bool _retired; // 本线程即将退出，池已清空：此后每释放一个节点即移交，每次分配单独申请
+
+    // 线程退出时析构，清空本线程的池并令其退役；于首次spill或refill时登记
+    // 池本身可平凡析构，故其后（如静态对象析构时）仍可访问，迟到的释放照常经由spill移交全局
+    struct Reaper
+    {
+        ~Reaper() { local().retire(); }
+    };
+
+    static std::mutex &orphanLock()
+    {
+        static std::mutex m;
+        return m;
+    }
+    static Slot *&orphans() // 移交全局的各批节点，每批至多NODE_POOL_CAP个
+    {
+        static Slot *list = NULL;
+        return list;
+    }
+    static void giveAway(Slot *batch)
+    {
+        if (!batch)
+            return;
+        std::lock_guard<std::mutex> lk(orphanLock());
+        batch->link.batch = orphans();
+        orphans() = batch;
+    }
+    static void enlist()
+    {
+        thread_local Reaper reaper;
+        (void)reaper;
+    }
+    void spill() // 整批移交_free，O(1)
+    {
+        if (!_retired)
+            enlist();
+        giveAway(_free);
+        _free = NULL;
+        _frees = _retired ? NODE_POOL_CAP - 1 : 0; // 退役后，下次释放随即再次移交
+    }
+    void refill() // _free与_carry均已空
+    {
+        if (_retired)
+        {
+            _carry = (Slot *)::operator new(sizeof(Slot));
+            _carry->link.next = NULL;
+            return;
+        }
+        enlist();
+        {
+            std::lock_guard<std::mutex> lk(orphanLock());
+            if ((_carry = orphans()))
+                orphans() = _carry->link.batch;
+        }
+        if (_carry)
+            return;
+        Slot *s = (Slot *)::operator new(NODE_POOL_SLAB * sizeof(Slot));
+        for (int i = 0; i < NODE_POOL_SLAB - 1; i++)
+            s[i].link.next = s + i + 1;
+        s[NODE_POOL_SLAB - 1].link.next = NULL;
+        _carry = s;
+    }
+    Slot *takeCarry()
+    {
+        if (!_carry)
+            refill();
+        Slot *s = _carry;
+        _carry = s->link.next;
+        return s;
+    }
+    void retire()
+    {
+        _retired = true;
+        spill();
+        giveAway(_carry); // 取自一批或一块slab，亦不超过NODE_POOL_CAP个
+        _carry = NULL;
+    }
+
+    constexpr NodePool() : _free(NULL), _carry(NULL), _frees(NODE_POOL_CAP - 1), _retired(false) {}
+    static NodePool &local() // 常量初始化且可平凡析构，每次访问无需检查是否已构造
+    {
+        thread_local NodePool pool;
+        return pool;
+    }
+
+public:
+    static void *allocate()
+    {
+        NodePool &pool = local();
+        Slot *s = pool._free;
+        if (!s)
+            return pool.takeCarry();
+        pool._free = s->link.next;
+        return s;
+    }
+    static void deallocate(void *p)
+    {
+        NodePool &pool = local();
+        Slot *s = (Slot *)p;
+        s->link.next = pool._free;
+        pool._free = s;
+        if (++pool._frees == NODE_POOL_CAP)
+            pool.spill();
+    }
+};
+
+#endif
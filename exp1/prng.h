@@ -0,0 +1,76 @@
+#ifndef PRNG_H
+#define PRNG_H
+
+#include <cstdint>
+#include <random>
+
+// xoshiro256**：周期2^256 - 1，每次输出64位，远快于rand()且各平台结果一致
+// 满足UniformRandomBitGenerator，可直接用于<random>中的分布与std::shuffle
+class Xoshiro256
+{
+private:
+    uint64_t s[4];
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+public:
+    typedef uint64_t result_type;
+    static constexpr uint64_t min() { return 0; }
+    static constexpr uint64_t max() { return UINT64_MAX; }
+
+    explicit Xoshiro256(uint64_t seed = 0x9E3779B97F4A7C15ull) { this->seed(seed); }
+    void seed(uint64_t seed) // 以splitmix64将64位种子扩展为256位状态，种子为0亦可
+    {
+        for (int i = 0; i < 4; i++)
+        {
+            uint64_t z = (seed += 0x9E3779B97F4A7C15ull);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            s[i] = z ^ (z >> 31);
+        }
+    }
+    uint64_t operator()()
+    {
+        uint64_t r = rotl(s[1] * 5, 7) * 9, t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return r;
+    }
+};
+
+// [0, n)内均匀分布的随机整数（n > 0）
+// 64位生成器用Lemire的乘法取高位法：通常无需除法，拒绝少数样本以消除取模偏差；其它生成器交由uniform_int_distribution
+template <typename RNG>
+uint64_t uniformBelow(RNG &g, uint64_t n)
+{
+#if defined(__SIZEOF_INT128__)
+    if (RNG::min() == 0 && RNG::max() == UINT64_MAX)
+    {
+        unsigned __int128 m = (unsigned __int128)g() * n;
+        uint64_t l = (uint64_t)m;
+        if (l < n)
+        {
+            uint64_t t = (0 - n) % n; // 2^64 mod n
+            while (l < t)
+            {
+                m = (unsigned __int128)g() * n;
+                l = (uint64_t)m;
+            }
+        }
+        return (uint64_t)(m >> 64);
+    }
+#endif
+    return std::uniform_int_distribution<uint64_t>(0, n - 1)(g);
+}
+
+// 每个线程各自的生成器，以random_device播种；供不指定生成器的unsort()等使用
+inline Xoshiro256 &threadRng()
+{
+    thread_local Xoshiro256 g(((uint64_t)std::random_device()() << 32) ^ std::random_device()());
+    return g;
+}
+
+#endif
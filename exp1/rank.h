@@ -0,0 +1,6 @@
+#ifndef RANK_H
+#define RANK_H
+
+typedef long long Rank; // 秩：64位，元素个数与所占字节数均可超过2^31；各容器共用
+
+#endif
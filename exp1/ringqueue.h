@@ -0,0 +1,103 @@
+#ifndef RINGQUEUE_H
+#define RINGQUEUE_H
+
+#include "vector.h"
+
+#define RING_QUEUE_MIN 16 // 首次入队时分配的容量
+
+// 环形缓冲区队列：元素连续存放于容量为2的幂的数组中，下标按位与回绕；满时容量加倍
+// 接口与Queue（基于List）相同，可直接以typedef替换；入队、出队均不访问堆（扩容除外）
+template <typename T, typename Alloc = allocator<T>>
+class RingQueue
+{
+private:
+    Alloc _alloc;
+    T *_elem;
+    Rank _capacity, _head, _size; // 队首位于_elem[_head]，其后_size个元素依次回绕存放
+
+    T *at(Rank i) const { return _elem + ((_head + i) & (_capacity - 1)); } // 队中第i个元素
+    template <typename... Args>
+    void growAndEmplace(Args &&...args) // 队满：先在新空间中构造新元素，再迁移原有元素，参数引用队中元素时也安全
+    {
+        Rank capacity = _capacity ? _capacity * 2 : RING_QUEUE_MIN;
+        T *elem = allocator_traits<Alloc>::allocate(_alloc, capacity);
+        new (elem + _size) T(std::forward<Args>(args)...);
+        Rank tail = min(_size, _capacity - _head); // 自_head至数组末端的一段
+        relocate(elem, _elem + _head, tail);
+        relocate(elem + tail, _elem, _size - tail);
+        if (_elem)
+            allocator_traits<Alloc>::deallocate(_alloc, _elem, _capacity);
+        _elem = elem;
+        _capacity = capacity;
+        _head = 0;
+        _size++;
+    }
+
+public:
+    RingQueue(Alloc const &a = Alloc()) : _alloc(a), _elem(NULL), _capacity(0), _head(0), _size(0) {}
+    RingQueue(RingQueue const &Q) : RingQueue(allocator_traits<Alloc>::select_on_container_copy_construction(Q._alloc))
+    {
+        for (Rank i = 0; i < Q._size; i++)
+            enqueue(*Q.at(i));
+    }
+    RingQueue(RingQueue &&Q) : _alloc(Q._alloc), _elem(Q._elem), _capacity(Q._capacity), _head(Q._head), _size(Q._size)
+    {
+        Q._elem = NULL;
+        Q._capacity = Q._head = Q._size = 0;
+    }
+    RingQueue &operator=(RingQueue Q)
+    {
+        swap(_alloc, Q._alloc);
+        swap(_elem, Q._elem);
+        swap(_capacity, Q._capacity);
+        swap(_head, Q._head);
+        swap(_size, Q._size);
+        return *this;
+    }
+    ~RingQueue()
+    {
+        clear();
+        if (_elem)
+            allocator_traits<Alloc>::deallocate(_alloc, _elem, _capacity);
+    }
+
+    Rank size() const { return _size; }
+    bool empty() const { return _size <= 0; }
+    Rank capacity() const { return _capacity; }
+    template <typename... Args>
+    void emplace(Args &&...args) // 在队尾就地构造
+    {
+        if (_size == _capacity)
+            growAndEmplace(std::forward<Args>(args)...);
+        else
+        {
+            new (at(_size)) T(std::forward<Args>(args)...);
+            _size++;
+        }
+    }
+    void enqueue(T const &e) { emplace(e); }
+    void enqueue(T &&e) { emplace(std::move(e)); }
+    T dequeue()
+    {
+        T *x = _elem + _head;
+        T e = std::move(*x);
+        x->~T();
+        _head = (_head + 1) & (_capacity - 1);
+        _size--;
+        return e;
+    }
+    T &front() { return _elem[_head]; }
+    T &rear() { return *at(_size - 1); }
+    T &operator[](Rank i) { return *at(i); }
+    Rank clear()
+    {
+        Rank oldSize = _size;
+        if (!is_trivially_destructible<T>::value)
+            for (Rank i = 0; i < _size; i++)
+                at(i)->~T();
+        _head = _size = 0;
+        return oldSize;
+    }
+};
+
+#endif
@@ -0,0 +1,68 @@
+#ifndef SMALLVECTOR_H
+#define SMALLVECTOR_H
+
+#include "vector.h"
+
+// 内嵌N个元素缓冲区的分配器：请求不超过N且缓冲区空闲时直接返回缓冲区，否则转交std::allocator
+// 缓冲区属于分配器对象本身，故分配器只与自身相等：Vector移动时不会接管对方的内嵌缓冲区，而是逐个迁移元素
+template <typename T, int N>
+class InlineAllocator
+{
+private:
+    alignas(T) unsigned char _buf[N * sizeof(T)];
+    bool _used;
+
+public:
+    typedef T value_type;
+    template <typename U>
+    struct rebind
+    {
+        typedef InlineAllocator<U, N> other;
+    };
+    InlineAllocator() : _used(false) {}
+    InlineAllocator(InlineAllocator const &) : _used(false) {} // 副本各用各的缓冲区
+    InlineAllocator &operator=(InlineAllocator const &) { return *this; }
+    T *allocate(size_t n)
+    {
+        if (n <= (size_t)N && !_used)
+        {
+            _used = true;
+            return (T *)_buf;
+        }
+        return allocator<T>().allocate(n);
+    }
+    void deallocate(T *p, size_t n)
+    {
+        if (p == (T *)_buf)
+            _used = false;
+        else
+            allocator<T>().deallocate(p, n);
+    }
+    bool operator==(InlineAllocator const &a) const { return this == &a; }
+    bool operator!=(InlineAllocator const &a) const { return this != &a; }
+};
+
+// 小向量：前N个元素存放于对象内部，规模不超过N时不访问堆
+template <typename T, int N>
+class SmallVector : public Vector<T, InlineAllocator<T, N>>
+{
+    typedef Vector<T, InlineAllocator<T, N>> Base;
+
+public:
+    using Base::Base;
+    SmallVector() : Base(N) {}
+    SmallVector(SmallVector const &V) : Base(N) { this->insert(0, V._elem, V._elem + V._size); } // Vector的复制预留两倍空间，会越出缓冲区
+    SmallVector(SmallVector &&) = default;
+    SmallVector &operator=(SmallVector const &V)
+    {
+        if (this != &V)
+        {
+            this->remove(0, this->_size);
+            this->insert(0, V._elem, V._elem + V._size);
+        }
+        return *this;
+    }
+    SmallVector &operator=(SmallVector &&) = default;
+};
+
+#endif
@@ -38,7 +38,7 @@ public:
     }
 };
 
-void convert(Stack<char> &S, __int64 n, int base)
+void convert(Stack<char> &S, long long n, int base)
 {
     static char digit[] = {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'};
     while (n > 0)
@@ -134,7 +134,8 @@ float calcu(float f1, char s, float f2)
     return 0;
 }
 
-void readNumber(char *&p, Stack<float> &stk)
+template <typename S>
+void readNumber(char *&p, S &stk)
 {
     float num = 0;
     // 读取整数部分
@@ -217,10 +218,11 @@ char orderBetween(char op1, char op2)
     return pri[optr2rank(op1)][optr2rank(op2)];
 }
 
-float evaluate(char *S, char *&RPN)
+template <typename OpndStack = Stack<float>, typename OptrStack = Stack<char>>
+float evaluate(char *S, char *&RPN) // 运算数栈、运算符栈的类型可以替换，如FastStack<float>、FastStack<char>
 {
-    Stack<float> opnd;
-    Stack<char> optr;
+    OpndStack opnd;
+    OptrStack optr;
     optr.push('\0');
     while (!optr.empty())
     {
@@ -0,0 +1,154 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// 工作窃取线程池：每个工作线程有自己的任务队列，自队尾取自己的任务，空闲时自其它队列队首窃取
+// 等待子任务的线程（包括池外的调用者）不会阻塞，而是在等待期间继续执行池中的任务，因此可以递归地分治
+class ThreadPool
+{
+private:
+    struct Worker
+    {
+        std::mutex m;
+        std::deque<std::function<void()>> q;
+    };
+    std::vector<std::unique_ptr<Worker>> _workers;
+    std::vector<std::thread> _threads;
+    std::atomic<bool> _stop;
+    std::atomic<int> _pending; // 尚未被取走的任务数
+    std::atomic<unsigned> _next; // 池外线程提交任务时轮流选择队列
+    std::mutex _sleepM;
+    std::condition_variable _sleepCV;
+
+    static ThreadPool const *&currentPool()
+    {
+        thread_local ThreadPool const *pool = NULL;
+        return pool;
+    }
+    static int &currentIndex()
+    {
+        thread_local int index = -1;
+        return index;
+    }
+    int self() const // 当前线程在本池中的编号，池外线程为-1
+    {
+        return (currentPool() == this) ? currentIndex() : -1;
+    }
+    bool pop(int i, bool back, std::function<void()> &task)
+    {
+        Worker &w = *_workers[i];
+        std::lock_guard<std::mutex> lk(w.m);
+        if (w.q.empty())
+            return false;
+        if (back)
+        {
+            task = std::move(w.q.back());
+            w.q.pop_back();
+        }
+        else
+        {
+            task = std::move(w.q.front());
+            w.q.pop_front();
+        }
+        _pending--;
+        return true;
+    }
+    void loop(int i)
+    {
+        currentPool() = this;
+        currentIndex() = i;
+        while (!_stop)
+        {
+            if (runOne())
+                continue;
+            std::unique_lock<std::mutex> lk(_sleepM);
+            _sleepCV.wait(lk, [this]() { return _stop || 0 < _pending; });
+        }
+    }
+
+public:
+    ThreadPool(int n) : _stop(false), _pending(0), _next(0) // 创建n个工作线程；n可以为0，此时任务全部由等待者执行
+    {
+        for (int i = 0; i < n || i == 0; i++)
+            _workers.emplace_back(new Worker);
+        for (int i = 0; i < n; i++)
+            _threads.emplace_back(&ThreadPool::loop, this, i);
+    }
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lk(_sleepM);
+            _stop = true;
+        }
+        _sleepCV.notify_all();
+        for (size_t i = 0; i < _threads.size(); i++)
+            _threads[i].join();
+    }
+    void submit(std::function<void()> task)
+    {
+        int i = self();
+        if (i < 0)
+            i = (int)(_next++ % _workers.size());
+        {
+            std::lock_guard<std::mutex> lk(_workers[i]->m);
+            _workers[i]->q.push_back(std::move(task));
+        }
+        _pending++;
+        {
+            std::lock_guard<std::mutex> lk(_sleepM);
+        }
+        _sleepCV.notify_one();
+    }
+    bool runOne() // 执行一个任务：优先取自己队列中最新的任务，否则窃取别人最早的任务；无任务可做时返回false
+    {
+        std::function<void()> task;
+        int me = self(), n = (int)_workers.size();
+        bool got = (0 <= me) && pop(me, true, task);
+        for (int k = 1; !got && k <= n; k++)
+        {
+            int i = (me + k + n) % n;
+            if (i != me)
+                got = pop(i, false, task);
+        }
+        if (got)
+            task();
+        return got;
+    }
+};
+
+// 一组可等待的任务
+class TaskGroup
+{
+private:
+    ThreadPool &_pool;
+    std::atomic<int> _running;
+
+public:
+    TaskGroup(ThreadPool &pool) : _pool(pool), _running(0) {}
+    ~TaskGroup() { wait(); }
+    template <typename F>
+    void run(F f)
+    {
+        _running++;
+        _pool.submit([this, f]() {
+            f();
+            _running--;
+        });
+    }
+    void wait() // 等待期间执行池中的其它任务
+    {
+        while (0 < _running)
+            if (!_pool.runOne())
+                std::this_thread::yield();
+    }
+};
+
+#endif
@@ -0,0 +1,332 @@
+#ifndef UNROLLEDLIST_H
+#define UNROLLEDLIST_H
+
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <utility>
+#include "nodepool.h"
+#include "rank.h"
+
+#ifndef LIST_NODE_POOL
+#define LIST_NODE_POOL 1 // 与ListNode.h一致：块取自NodePool；定义为0则退回全局new/delete
+#endif
+
+#define UNROLLED_CHUNK_BYTES 512 // 默认块容量：使每块的元素约占这么多字节，且不少于8个
+
+// 展开链表的块：元素存放于slot()[lo, hi)，向尾部追加时hi增长，向首部插入时lo减小
+template <typename T, int K>
+struct UnrolledChunk
+{
+    UnrolledChunk *pred, *succ;
+    int lo, hi;
+    alignas(T) unsigned char buf[K * sizeof(T)];
+
+    UnrolledChunk(int at, UnrolledChunk *p, UnrolledChunk *s) : pred(p), succ(s), lo(at), hi(at) {}
+    T *slot() { return (T *)buf; }
+    int size() const { return hi - lo; }
+
+#if LIST_NODE_POOL
+    static void *operator new(size_t) { return NodePool<sizeof(UnrolledChunk), alignof(UnrolledChunk)>::allocate(); }
+    static void operator delete(void *p) { NodePool<sizeof(UnrolledChunk), alignof(UnrolledChunk)>::deallocate(p); }
+#endif
+};
+
+// 展开链表：每个节点（块）容纳至多K个元素，接口与List相仿
+// 与List相比，每个元素分摊的指针开销降至1/K，遍历时每K个元素才跨越一次节点
+// 首尾插入、删除均为O(1)；按秩访问、删除为O(n/K + K)；删除致使相邻两块合计不足K/2时合二为一
+template <typename T, int K = (UNROLLED_CHUNK_BYTES / sizeof(T) < 8 ? 8 : UNROLLED_CHUNK_BYTES / sizeof(T))>
+class UnrolledList
+{
+private:
+    typedef UnrolledChunk<T, K> Chunk;
+    Rank _size;
+    Chunk *_first, *_last; // 列表为空时均为NULL
+
+    Chunk *link(int at, Chunk *p, Chunk *s) // 在块p、s之间接入新块，其元素自at处开始
+    {
+        Chunk *c = new Chunk(at, p, s);
+        (p ? p->succ : _first) = c;
+        (s ? s->pred : _last) = c;
+        return c;
+    }
+    void unlink(Chunk *c) // 摘除并释放空块c
+    {
+        (c->pred ? c->pred->succ : _first) = c->succ;
+        (c->succ ? c->succ->pred : _last) = c->pred;
+        delete c;
+    }
+    Chunk *locate(Rank &r) const // 秩为r的元素所在块；r随之改为块内下标（自slot()起计）
+    {
+        Chunk *c;
+        if (r < _size / 2)
+            for (c = _first; c->size() <= r; c = c->succ)
+                r -= c->size();
+        else
+        {
+            r = _size - r;
+            for (c = _last; c->size() < r; c = c->pred)
+                r -= c->size();
+            r = c->size() - r;
+        }
+        r += c->lo;
+        return c;
+    }
+    void absorb(Chunk *c) // 将后继块的元素并入c，并释放后继块；调用者须保证二者合计不超过K
+    {
+        Chunk *s = c->succ;
+        T *a = c->slot(), *b = s->slot();
+        if (K < c->lo + c->size() + s->size()) // 先将c的元素移至块首
+        {
+            for (int i = c->lo; i < c->hi; i++)
+            {
+                new (a + i - c->lo) T(std::move(a[i]));
+                a[i].~T();
+            }
+            c->hi -= c->lo;
+            c->lo = 0;
+        }
+        for (int i = s->lo; i < s->hi; i++)
+        {
+            new (a + c->hi++) T(std::move(b[i]));
+            b[i].~T();
+        }
+        unlink(s);
+    }
+    void shrink(Chunk *c) // 删除后收缩：块空则释放，与邻块合计不足K/2则合并
+    {
+        if (!c->size())
+            unlink(c);
+        else if (c->succ && c->size() + c->succ->size() <= K / 2)
+            absorb(c);
+        else if (c->pred && c->pred->size() + c->size() <= K / 2)
+            absorb(c->pred);
+    }
+
+    struct Run // 已排序的一段：由first至last的块链（last->succ为NULL），共n个元素
+    {
+        Chunk *first, *last;
+        Rank n;
+    };
+    static void move(T *dst, T *src) // 将*src迁至未初始化的*dst
+    {
+        new (dst) T(std::move(*src));
+        src->~T();
+    }
+    static void sortChunk(Chunk *c);
+    static Run merge(Run a, Run b);
+
+public:
+    typedef T value_type;
+
+    UnrolledList() : _size(0), _first(NULL), _last(NULL) {}
+    UnrolledList(UnrolledList const &L) : _size(0), _first(NULL), _last(NULL)
+    {
+        for (Chunk *c = L._first; c; c = c->succ)
+            for (int i = c->lo; i < c->hi; i++)
+                insertAsLast(c->slot()[i]);
+    }
+    UnrolledList(UnrolledList &&L) : _size(L._size), _first(L._first), _last(L._last)
+    {
+        L._size = 0;
+        L._first = L._last = NULL;
+    }
+    UnrolledList &operator=(UnrolledList L)
+    {
+        std::swap(_size, L._size);
+        std::swap(_first, L._first);
+        std::swap(_last, L._last);
+        return *this;
+    }
+    ~UnrolledList() { clear(); }
+
+    Rank size() const { return _size; }
+    bool empty() const { return _size <= 0; }
+    T &front() const { return _first->slot()[_first->lo]; }
+    T &back() const { return _last->slot()[_last->hi - 1]; }
+    T &operator[](Rank r) const
+    {
+        Chunk *c = locate(r);
+        return c->slot()[r];
+    }
+
+    void insertAsFirst(T const &e)
+    {
+        if (!_first || _first->lo == 0)
+            link(K, NULL, _first);
+        new (_first->slot() + _first->lo - 1) T(e);
+        _first->lo--;
+        _size++;
+    }
+    void insertAsLast(T const &e)
+    {
+        if (!_last || _last->hi == K)
+            link(0, _last, NULL);
+        new (_last->slot() + _last->hi) T(e);
+        _last->hi++;
+        _size++;
+    }
+    T removeFirst()
+    {
+        T *x = _first->slot() + _first->lo++;
+        T e = std::move(*x);
+        x->~T();
+        _size--;
+        if (!_first->size())
+            unlink(_first);
+        return e;
+    }
+    T removeLast()
+    {
+        T *x = _last->slot() + --_last->hi;
+        T e = std::move(*x);
+        x->~T();
+        _size--;
+        if (!_last->size())
+            unlink(_last);
+        return e;
+    }
+    T remove(Rank r) // 删除秩为r的元素：块内较短的一侧向空位平移
+    {
+        Chunk *c = locate(r);
+        T *a = c->slot();
+        T e = std::move(a[r]);
+        if (r - c->lo < c->hi - 1 - r)
+        {
+            for (Rank i = r; c->lo < i; i--)
+                a[i] = std::move(a[i - 1]);
+            a[c->lo++].~T();
+        }
+        else
+        {
+            for (Rank i = r; i < c->hi - 1; i++)
+                a[i] = std::move(a[i + 1]);
+            a[--c->hi].~T();
+        }
+        _size--;
+        shrink(c);
+        return e;
+    }
+    Rank clear()
+    {
+        Rank oldSize = _size;
+        while (_first)
+        {
+            for (int i = _first->lo; i < _first->hi; i++)
+                _first->slot()[i].~T();
+            _first->lo = _first->hi;
+            unlink(_first);
+        }
+        _size = 0;
+        return oldSize;
+    }
+
+    void traverse(void (*visit)(T &))
+    {
+        for (Chunk *c = _first; c; c = c->succ)
+            for (T *p = c->slot() + c->lo, *end = c->slot() + c->hi; p != end; p++)
+                visit(*p);
+    }
+    template <typename VST>
+    void traverse(VST &&visit)
+    {
+        for (Chunk *c = _first; c; c = c->succ)
+            for (T *p = c->slot() + c->lo, *end = c->slot() + c->hi; p != end; p++)
+                visit(*p);
+    }
+
+    void sort(); // 稳定：各块先就地排序，再以块为单位归并；额外空间O(K)，排序后各块（末块除外）均满
+};
+
+template <typename T, int K>
+void UnrolledList<T, K>::sortChunk(Chunk *c) // 块内自底向上归并排序：元素在块与栈上的缓冲区之间往返，每趟各迁移一次
+{
+    alignas(T) unsigned char buf[K * sizeof(T)];
+    int n = c->size();
+    T *src = c->slot() + c->lo, *dst = (T *)buf;
+    for (int w = 1; w < n; w *= 2)
+    {
+        for (int lo = 0; lo < n; lo += 2 * w)
+        {
+            int mi = (lo + w < n) ? lo + w : n, hi = (lo + 2 * w < n) ? lo + 2 * w : n;
+            int i = lo, j = mi, k = lo;
+            while (i < mi && j < hi)
+                move(dst + k++, (src[j] < src[i]) ? src + j++ : src + i++);
+            while (i < mi)
+                move(dst + k++, src + i++);
+            while (j < hi)
+                move(dst + k++, src + j++);
+        }
+        std::swap(src, dst);
+    }
+    if (src != c->slot() + c->lo) // 末趟结果在缓冲区中
+        for (int i = 0; i < n; i++)
+            move(dst + i, src + i);
+}
+
+template <typename T, int K>
+typename UnrolledList<T, K>::Run UnrolledList<T, K>::merge(Run a, Run b) // 归并为一段满块：输入块取空即释放，故任何时刻至多多占两个块；稳定
+{
+    Run r = {NULL, NULL, a.n + b.n};
+    Chunk *ca = a.first, *cb = b.first;
+    int ia = ca->lo, ib = cb->lo;
+    for (Rank k = 0; k < r.n; k++)
+    {
+        if (!r.last || r.last->hi == K)
+        {
+            Chunk *c = new Chunk(0, r.last, NULL);
+            (r.last ? r.last->succ : r.first) = c;
+            r.last = c;
+        }
+        Chunk *&c = (!cb || (ca && !(cb->slot()[ib] < ca->slot()[ia]))) ? ca : cb; // 相等时取前段者
+        int &i = (&c == &ca) ? ia : ib;
+        move(r.last->slot() + r.last->hi++, c->slot() + i++);
+        if (i == c->hi)
+        {
+            Chunk *next = c->succ;
+            delete c;
+            if ((c = next))
+                i = c->lo;
+        }
+    }
+    return r;
+}
+
+template <typename T, int K>
+void UnrolledList<T, K>::sort() // 与List::naturalMergeSort相同的段栈：相邻块首尾有序时直接并为一段，有序的输入无需归并
+{
+    if (_size < 2)
+        return;
+    Run run[64];
+    int top = 0;
+    for (Chunk *c = _first, *next; c; c = next)
+    {
+        next = c->succ;
+        c->pred = c->succ = NULL;
+        sortChunk(c);
+        if (top && !(c->slot()[c->lo] < run[top - 1].last->slot()[run[top - 1].last->hi - 1]))
+        {
+            Run &t = run[top - 1];
+            c->pred = t.last;
+            t.last->succ = c;
+            t.last = c;
+            t.n += c->size();
+        }
+        else
+        {
+            Run t = {c, c, c->size()};
+            run[top++] = t;
+        }
+        while (1 < top && run[top - 2].n <= 2 * run[top - 1].n)
+        {
+            run[top - 2] = merge(run[top - 2], run[top - 1]);
+            top--;
+        }
+    }
+    for (; 1 < top; top--)
+        run[top - 2] = merge(run[top - 2], run[top - 1]);
+    _first = run[0].first;
+    _last = run[0].last;
+}
+
+#endif
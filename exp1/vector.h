@@ -1,141 +1,455 @@
+#ifndef VECTOR_H
+#define VECTOR_H
+
 #include <iostream>
 #include "fib.h"
+#include "prng.h"
 #include <algorithm>
 #include <utility>
+#include <cstring>
+#include <type_traits>
+#include <memory>
+#include <new>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
 
 using namespace std;
 
-typedef int Rank;
+#include "rank.h"
+#include "vector_simd.h"
+
 #define DEFAULT_CAPACITY 30
+#define INSERTION_SORT_THRESHOLD 16 // 规模不超过此值的区间直接插入排序
+#define SEARCH_BATCH 8                // search_many中交错推进的查找个数
+#define SHRINK_LOAD 4                 // 装填因子低于1/SHRINK_LOAD时缩容
+#define DEDUP_LOAD_SHIFT 1            // deduplicate中散列表的槽数不少于元素数的2^DEDUP_LOAD_SHIFT倍
 
-template <typename T>
+#if defined(__GNUC__)
+#define PREFETCH(p) __builtin_prefetch(p)
+#else
+#define PREFETCH(p)
+#endif
+
+typedef enum
+{
+    SORT_INTRO, // 默认：内省排序（快排 + 堆排序兜底 + 小区间插入排序）
+    SORT_BUBBLE,
+    SORT_SELECTION,
+    SORT_MERGE,
+    SORT_HEAP,
+    SORT_QUICK,
+    SORT_MERGE_BOTTOM_UP // 自底向上的迭代归并排序
+} SortStrategy;
+
+// 扩容策略：grow(c)给出容量c装满后的新容量，须满足c < grow(c) <= 2c
+struct GrowthDouble // 加倍（默认）
+{
+    static Rank grow(Rank c) { return c << 1; }
+};
+struct GrowthOneAndHalf // 1.5倍：峰值内存更小，扩容次数更多
+{
+    static Rank grow(Rank c) { return c + (c >> 1); }
+};
+template <Rank K>
+struct GrowthChunk // 每次追加固定的K个单元：内存最省，但连续追加n个元素需O(n^2 / K)时间
+{
+    static Rank grow(Rank c) { return c + ((K < c) ? K : c); }
+};
+
+struct MemoryStats
+{
+    size_t reserved;         // 已申请的字节数（容量）
+    size_t used;             // 元素所占的字节数（规模）
+    long long reallocations; // 自构造以来的重分配次数
+};
+
+template <typename V>
+class VectorParallel; // 并行算法，见vector_parallel.h
+
+template <typename T, typename Alloc = allocator<T>, typename Growth = GrowthDouble> // Alloc：分配器，可以有状态（如ArenaAllocator）；Growth：扩容策略
 class Vector
 {
+    friend class VectorParallel<Vector>;
+
 protected:
+    Alloc _alloc;
     Rank _size;
-    int _capacity;
-    T *_elem;
+    Rank _capacity;
+    T *_elem; // [0, _size)为已构造的元素，[_size, _capacity)为未初始化的原始空间
+    long long _reallocs;
+    T *allocate(Rank n) { return allocator_traits<Alloc>::allocate(_alloc, n); }
+    void deallocate(T *p, Rank n)
+    {
+        if (p)
+            allocator_traits<Alloc>::deallocate(_alloc, p, n);
+    }
+    void destroy(Rank lo, Rank hi);
+    void reallocate(Rank c);
     void copyFrom(T const *A, Rank lo, Rank hi);
+    Rank grownCapacity(Rank k) const;
     void expand();
     void shrink();
     bool bubble(Rank lo, Rank hi);
     void bubblesort(Rank lo, Rank hi);
     Rank max(Rank lo, Rank hi);
     void selectionSort(Rank lo, Rank hi);
-    void merge(Rank lo, Rank mi, Rank hi);
+    void merge(Rank lo, Rank mi, Rank hi, T *B);
     void mergeSort(Rank lo, Rank hi);
+    void mergeSort(Rank lo, Rank hi, T *B);
+    void mergeSortBottomUp(Rank lo, Rank hi, T *B);
+    static Rank bottomUpBufferSize(Rank n);
     Rank partition(Rank lo, Rank hi);
     void quickSort(Rank lo, Rank hi);
     void heapSort(Rank lo, Rank hi);
+    void siftDown(Rank lo, Rank i, Rank n);
+    void insertionSort(Rank lo, Rank hi);
+    void introSort(Rank lo, Rank hi, int depth);
+    Rank keepFlagged(char const *keep);
+    T *openGap(Rank r, Rank k);
+    template <typename It>
+    static T const *addressOf(It) { return NULL; }
+    static T const *addressOf(T *p) { return p; }
+    static T const *addressOf(T const *p) { return p; }
 
 public:
-    Vector(int c = DEFAULT_CAPACITY, int s = 0, T v = 0)
+    typedef T value_type;
+    typedef T *iterator; // 连续存放，迭代器即指针
+    typedef T const *const_iterator;
+
+    Vector(Rank c = DEFAULT_CAPACITY, Alloc const &a = Alloc()) : _alloc(a), _reallocs(0)
     {
-        _elem = new T[_capacity = c];
-        for (_size = 0; _size < s; _elem[_size++] = v)
-            ;
+        _elem = allocate(_capacity = c);
+        _size = 0;
+    }
+    Vector(Rank c, Rank s, T const &v = T(), Alloc const &a = Alloc()) : _alloc(a), _reallocs(0)
+    {
+        _elem = allocate(_capacity = (c < s) ? s : c);
+        for (_size = 0; _size < s; _size++)
+            new (_elem + _size) T(v);
+    }
+    // 以下两个构造函数只接受指针：Rank宽于int，若形参直接写作T const *，Vector(0, 5)中的0转为指针与转为Rank一样好，会与上面的Vector(c, s)歧义
+    template <typename P, typename = typename enable_if<is_convertible<P, T const *>::value && !is_integral<P>::value>::type>
+    Vector(P A, Rank n, Alloc const &a = Alloc()) : _alloc(a), _reallocs(0) { copyFrom(A, 0, n); }
+    template <typename P, typename = typename enable_if<is_convertible<P, T const *>::value && !is_integral<P>::value>::type>
+    Vector(P A, Rank lo, Rank hi, Alloc const &a = Alloc()) : _alloc(a), _reallocs(0) { copyFrom(A, lo, hi); }
+    Vector(Vector const &V) : _alloc(allocator_traits<Alloc>::select_on_container_copy_construction(V._alloc)), _reallocs(0) { copyFrom(V._elem, 0, V._size); }
+    Vector(Vector const &V, Rank lo, Rank hi) : _alloc(allocator_traits<Alloc>::select_on_container_copy_construction(V._alloc)), _reallocs(0) { copyFrom(V._elem, lo, hi); }
+    Vector(Vector &&V);
+    ~Vector()
+    {
+        destroy(0, _size);
+        deallocate(_elem, _capacity);
     }
-    Vector(T const *A, Rank n) { copyFrom(A, 0, n); }
-    Vector(T const *A, Rank lo, Rank hi) { copyFrom(A, lo, hi); }
-    Vector(Vector<T> const &V) { copyFrom(V._elem, 0, V._size); }
-    Vector(Vector<T> const &V, Rank lo, Rank hi) { copyFrom(V._elem, lo, hi); }
-    ~Vector() { delete[] _elem; }
 
     Rank size() const { return _size; }
+    Rank capacity() const { return _capacity; }
+    Alloc get_allocator() const { return _alloc; }
+    MemoryStats memory_stats() const
+    {
+        MemoryStats m = {(size_t)_capacity * sizeof(T), (size_t)_size * sizeof(T), _reallocs};
+        return m;
+    }
+    Rank max_size() const // 规模上限：取Rank与分配器所能表示者中的较小者
+    {
+        unsigned long long n = allocator_traits<Alloc>::max_size(_alloc);
+        return (n < (unsigned long long)numeric_limits<Rank>::max()) ? (Rank)n : numeric_limits<Rank>::max();
+    }
     bool empty() const { return !_size; }
-    int disordered() const;
+    Rank disordered() const;
     Rank find(T const &e) const { return find(e, 0, _size); }
     Rank find(T const &e, Rank lo, Rank hi) const;
     Rank search(T const &e) const { return (0 >= _size) ? -1 : search(e, 0, _size); }
     Rank search(T const &e, Rank lo, Rank hi) const;
+    Rank searchBranchless(T const &e) const { return searchBranchless(e, 0, _size); }
+    Rank searchBranchless(T const &e, Rank lo, Rank hi) const;
+    Vector<Rank> search_many(Vector const &keys) const;
     T &operator[](Rank r) const;
-    Vector<T> &operator=(Vector<T> const &);
+    T *data() { return _elem; }
+    T const *data() const { return _elem; }
+    iterator begin() { return _elem; }
+    iterator end() { return _elem + _size; }
+    const_iterator begin() const { return _elem; }
+    const_iterator end() const { return _elem + _size; }
+    Vector &operator=(Vector const &);
+    Vector &operator=(Vector &&);
     T remove(Rank r);
-    int remove(Rank lo, Rank hi);
+    Rank remove(Rank lo, Rank hi);
     Rank insert(Rank r, T const &e);
     Rank insert(T const &e) { return insert(_size, e); }
+    template <typename It, typename = typename iterator_traits<It>::iterator_category> // 仅匹配迭代器，以免与insert(r, n, e)混淆
+    Rank insert(Rank r, It first, It last);
+    Rank insert(Rank r, Rank n, T const &e);
+    template <typename Pred>
+    Rank erase_if(Pred pred);
+    void reserve(Rank n);
+    template <typename... Args>
+    T &emplace_back(Args &&...args);
+    void resize(Rank n);
+    void resize(Rank n, T const &v);
     void sort(Rank lo, Rank hi);
-    void sort(Rank lo, Rank hi,int i);
+    void sort(Rank lo, Rank hi, SortStrategy s);
+    void mergeSort(Rank lo, Rank hi, Vector &scratch);
+    void mergeSortBottomUp(Rank lo, Rank hi, Vector &scratch);
     void sort() { sort(0, _size); }
-    void unsort(Rank lo, Rank hi);
+    void unsort(Rank lo, Rank hi) { unsort(lo, hi, threadRng()); }
     void unsort() { unsort(0, _size); }
-    int deduplicate();
-    int uniquify();
+    template <typename RNG>
+    void unsort(RNG &rng) { unsort(0, _size, rng); }
+    template <typename RNG>
+    void unsort(Rank lo, Rank hi, RNG &rng);
+    Rank deduplicate();
+    Rank deduplicate_ordered();
+    Rank uniquify();
     void traverse(void (*)(T &));
     template <typename VST>
-    void traverse(VST &);
+    void traverse(VST &&visit); // 函数对象或lambda：以模板参数传入，可以内联
 };
 
+// 将src起的n个元素搬到dst（dst <= src，区间可重叠）：可平凡复制的类型直接memmove，否则逐个移动
 template <typename T>
-void Vector<T>::copyFrom(T const *A, Rank lo, Rank hi)
+static void moveForward(T *dst, T *src, Rank n)
 {
-    _elem = new T[_capacity = 2 * (hi - lo)];
-    _size = 0;
-    while (lo < hi)
+    if (is_trivially_copyable<T>::value)
+    {
+        if (0 < n)
+            memmove((void *)dst, (void const *)src, n * sizeof(T));
+    }
+    else
+        for (Rank i = 0; i < n; i++)
+            dst[i] = std::move(src[i]);
+}
+
+// 同上，但dst >= src，自后向前搬运
+template <typename T>
+static void moveBackward(T *dst, T *src, Rank n)
+{
+    if (is_trivially_copyable<T>::value)
     {
-        _elem[_size++] = A[lo++];
+        if (0 < n)
+            memmove((void *)dst, (void const *)src, n * sizeof(T));
     }
+    else
+        for (Rank i = n; 0 < i; i--)
+            dst[i - 1] = std::move(src[i - 1]);
 }
 
+// 将src起的n个元素迁入未初始化的dst（两区间不重叠），迁移后src处的元素均已析构
 template <typename T>
-Vector<T> &Vector<T>::operator=(Vector<T> const &V)
+static void relocate(T *dst, T *src, Rank n)
+{
+    if (is_trivially_copyable<T>::value)
+    {
+        if (0 < n)
+            memcpy((void *)dst, (void const *)src, n * sizeof(T));
+    }
+    else
+        for (Rank i = 0; i < n; i++)
+        {
+            new (dst + i) T(std::move(src[i]));
+            src[i].~T();
+        }
+}
+
+// 将src起的n个元素迁至dst（dst >= src，区间可重叠），自后向前逐个迁移；迁移后src处不与dst重叠的部分已析构
+template <typename T>
+static void relocateBackward(T *dst, T *src, Rank n)
+{
+    if (is_trivially_copyable<T>::value)
+    {
+        if (0 < n)
+            memmove((void *)dst, (void const *)src, n * sizeof(T));
+    }
+    else
+        for (Rank i = n; 0 < i; i--)
+        {
+            new (dst + i - 1) T(std::move(src[i - 1]));
+            src[i - 1].~T();
+        }
+}
+
+template <typename T, typename Alloc, typename Growth>
+void Vector<T, Alloc, Growth>::destroy(Rank lo, Rank hi)
 {
-    if (_elem)
-        delete[] _elem;
+    if (!is_trivially_destructible<T>::value)
+        while (lo < hi)
+            _elem[lo++].~T();
+}
+
+template <typename T, typename Alloc, typename Growth>
+void Vector<T, Alloc, Growth>::reallocate(Rank c)
+{
+    T *oldElem = _elem;
+    _elem = allocate(c);
+    _reallocs++;
+    relocate(_elem, oldElem, _size);
+    deallocate(oldElem, _capacity);
+    _capacity = c;
+}
+
+template <typename T, typename Alloc, typename Growth>
+void Vector<T, Alloc, Growth>::copyFrom(T const *A, Rank lo, Rank hi)
+{
+    _elem = allocate(_capacity = (hi - lo <= max_size() / 2) ? 2 * (hi - lo) : hi - lo);
+    _size = hi - lo;
+    if (is_trivially_copyable<T>::value)
+    {
+        if (0 < _size)
+            memcpy((void *)_elem, (void const *)(A + lo), _size * sizeof(T));
+    }
+    else
+        uninitialized_copy(A + lo, A + hi, _elem);
+}
+
+template <typename T, typename Alloc, typename Growth>
+Vector<T, Alloc, Growth> &Vector<T, Alloc, Growth>::operator=(Vector const &V)
+{
+    if (this == &V)
+        return *this;
+    destroy(0, _size);
+    deallocate(_elem, _capacity);
     copyFrom(V._elem, 0, V.size());
     return *this;
 }
 
-template <typename T>
-void Vector<T>::expand()
+template <typename T, typename Alloc, typename Growth>
+Vector<T, Alloc, Growth>::Vector(Vector &&V) : _alloc(V._alloc), _size(V._size), _capacity(V._capacity), _elem(V._elem), _reallocs(0)
+{
+    if (_alloc == V._alloc) // 接管V的空间，V置为空向量
+    {
+        V._elem = NULL;
+        V._size = V._capacity = 0;
+        return;
+    }
+    _elem = allocate(_capacity); // 分配器不等（如内嵌缓冲区）时，V的空间不能由本向量释放，只能逐个迁移
+    relocate(_elem, V._elem, _size);
+    V._size = 0;
+}
+
+template <typename T, typename Alloc, typename Growth>
+Vector<T, Alloc, Growth> &Vector<T, Alloc, Growth>::operator=(Vector &&V) // 分配器不随赋值传播，故仅当二者相等时接管V的空间
+{
+    if (this == &V)
+        return *this;
+    destroy(0, _size);
+    if (!(_alloc == V._alloc))
+    {
+        _size = 0;
+        reserve(V._size);
+        relocate(_elem, V._elem, V._size);
+        _size = V._size;
+        V._size = 0;
+        return *this;
+    }
+    deallocate(_elem, _capacity);
+    _elem = V._elem;
+    _size = V._size;
+    _capacity = V._capacity;
+    V._elem = NULL;
+    V._size = V._capacity = 0;
+    return *this;
+}
+
+template <typename T, typename Alloc, typename Growth>
+void Vector<T, Alloc, Growth>::expand()
 {
     if (_size < _capacity)
         return;
-    if (_capacity < DEFAULT_CAPACITY)
-        _capacity = DEFAULT_CAPACITY;
-    T *oldelem = _elem;
-    _elem = new T[_capacity <<= 1];
-    for (int i = 0; i < _size; i++)
-        _elem[i] = oldelem[i];
-    delete[] oldelem;
+    reallocate(grownCapacity(1));
 }
-template <typename T>
-void Vector<T>::shrink()
+template <typename T, typename Alloc, typename Growth>
+Rank Vector<T, Alloc, Growth>::grownCapacity(Rank k) const // 再容纳k个元素所需的新容量：按Growth扩容，但不超过max_size()；规模超限则抛出length_error
 {
+    if (k > max_size() - _size)
+        throw length_error("Vector: size would exceed max_size()");
+    Rank c = (_capacity < DEFAULT_CAPACITY) ? DEFAULT_CAPACITY : _capacity;
+    c = (c <= max_size() / 2) ? Growth::grow(c) : max_size();
+    return (c < _size + k) ? _size + k : c;
+}
+template <typename T, typename Alloc, typename Growth>
+void Vector<T, Alloc, Growth>::shrink() // 装填因子低于1/SHRINK_LOAD时缩至规模的两倍
+{ // 扩容只在装满时发生，缩容后装填因子为1/2：两个阈值之间留有滞回区间，在阈值附近反复插入、删除不会来回重分配
     if (_capacity < DEFAULT_CAPACITY << 1)
         return;
-    if (_size << 2 > _capacity)
+    if (_capacity / SHRINK_LOAD <= _size)
         return;
-    T *oldElem = _elem;
-    _elem = new T[_capacity >>= 1];
-    for (int i = 0; i < _size; i++)
-        _elem[i] = oldElem[i];
-    delete[] oldElem;
+    Rank c = _size << 1;
+    reallocate((c < DEFAULT_CAPACITY) ? DEFAULT_CAPACITY : c);
 }
 
-template <typename T>
-T &Vector<T>::operator[](Rank r) const
+template <typename T, typename Alloc, typename Growth>
+void Vector<T, Alloc, Growth>::reserve(Rank n)
 {
-    return _elem[r];
+    if (max_size() < n)
+        throw length_error("Vector: reserve() exceeds max_size()");
+    if (_capacity < n)
+        reallocate(n);
 }
 
-template <typename T>
-void permute(Vector<T> &V)
+template <typename T, typename Alloc, typename Growth>
+template <typename... Args>
+T &Vector<T, Alloc, Growth>::emplace_back(Args &&...args)
 {
-    for (int i = V._size; i > 0; i--)
+    if (_size < _capacity)
+        new (_elem + _size) T(std::forward<Args>(args)...);
+    else
     {
-        swap(V[i - 1], V[rand() % i]);
+        T x(std::forward<Args>(args)...); // 参数可能引用本向量中的元素，须在扩容前构造
+        expand();
+        new (_elem + _size) T(std::move(x));
     }
+    return _elem[_size++];
 }
 
-template <typename T>
-void Vector<T>::unsort(Rank lo, Rank hi)
+template <typename T, typename Alloc, typename Growth>
+void Vector<T, Alloc, Growth>::resize(Rank n)
 {
-    T *V = _elem + lo;
-    for (Rank i = hi - lo; i > 0; i--)
+    if (n <= _size)
     {
-        swap(V[i - 1], V[rand() % i]);
+        destroy(n, _size);
+        _size = n;
+        return;
     }
+    reserve(n);
+    for (; _size < n; _size++)
+        new (_elem + _size) T();
+}
+
+template <typename T, typename Alloc, typename Growth>
+void Vector<T, Alloc, Growth>::resize(Rank n, T const &v)
+{
+    if (n <= _size)
+    {
+        destroy(n, _size);
+        _size = n;
+        return;
+    }
+    T x(v);
+    reserve(n);
+    for (; _size < n; _size++)
+        new (_elem + _size) T(x);
+}
+
+template <typename T, typename Alloc, typename Growth>
+T &Vector<T, Alloc, Growth>::operator[](Rank r) const
+{
+    return _elem[r];
+}
+
+template <typename T, typename Alloc, typename Growth>
+void permute(Vector<T, Alloc, Growth> &V)
+{
+    V.unsort();
+}
+
+template <typename T, typename Alloc, typename Growth>
+template <typename RNG>
+void Vector<T, Alloc, Growth>::unsort(Rank lo, Rank hi, RNG &rng) // Fisher-Yates：给定种子，结果与平台无关
+{
+    T *V = _elem + lo;
+    for (Rank i = hi - lo; i > 1; i--)
+        swap(V[i - 1], V[uniformBelow(rng, i)]);
 }
 
 template <typename T>
@@ -147,111 +461,235 @@ static bool eq(T *a, T *b) { return eq(*a, *b); }
 template <typename T>
 static bool eq(T &a, T &b) { return a == b; }
 
-template <typename T>
-Rank Vector<T>::find(T const &e, Rank lo, Rank hi) const
+template <typename T, typename Alloc, typename Growth>
+Rank Vector<T, Alloc, Growth>::find(T const &e, Rank lo, Rank hi) const
 {
-    while ((lo < hi--) && (e != _elem[hi]))
-        ;
-    return hi;
+    return findLast(_elem, e, lo, hi);
 }
 
-template <typename T>
-Rank Vector<T>::insert(Rank r, T const &e)
+template <typename T, typename Alloc, typename Growth>
+Rank Vector<T, Alloc, Growth>::insert(Rank r, T const &e)
 {
+    T x(e); // e可能就是本向量中的元素，须在搬动前复制
     expand();
-    for (int i = _size; i > r; i--)
+    if (r == _size)
+        new (_elem + r) T(std::move(x));
+    else
     {
-        _elem[i] = _elem[i - 1];
+        new (_elem + _size) T(std::move(_elem[_size - 1])); // 末元素迁入原始空间
+        moveBackward(_elem + r + 1, _elem + r, _size - 1 - r);
+        _elem[r] = std::move(x);
     }
-    _elem[r] = e;
     _size++;
     return r;
 }
 
-template <typename T>
-int Vector<T>::remove(Rank lo, Rank hi)
+template <typename T, typename Alloc, typename Growth>
+T *Vector<T, Alloc, Growth>::openGap(Rank r, Rank k) // 在秩r处腾出k个未初始化的位置（至多扩容一次），返回其起始地址；_size随之增加
 {
-    if (lo == hi)
-        return 0;
-    while (hi < _size)
+    if (_capacity - _size < k)
     {
-        _elem[lo++] = _elem[hi++];
+        Rank c = grownCapacity(k);
+        T *oldElem = _elem;
+        _elem = allocate(c);
+        _reallocs++;
+        relocate(_elem, oldElem, r);
+        relocate(_elem + r + k, oldElem + r, _size - r);
+        deallocate(oldElem, _capacity);
+        _capacity = c;
     }
-    _size = lo;
+    else
+        relocateBackward(_elem + r + k, _elem + r, _size - r);
+    _size += k;
+    return _elem + r;
+}
+
+template <typename T, typename Alloc, typename Growth>
+template <typename It, typename>
+Rank Vector<T, Alloc, Growth>::insert(Rank r, It first, It last) // 将[first, last)整体插至秩r处，尾部只搬动一次
+{
+    Rank k = (Rank)distance(first, last);
+    if (k <= 0)
+        return r;
+    T const *p = addressOf(first);
+    if (p && _elem <= p && p < _elem + _size) // 区间取自本向量，先复制出来
+    {
+        Vector tmp(p, k, _alloc);
+        return insert(r, tmp._elem, tmp._elem + k);
+    }
+    uninitialized_copy(first, last, openGap(r, k));
+    return r;
+}
+
+template <typename T, typename Alloc, typename Growth>
+Rank Vector<T, Alloc, Growth>::insert(Rank r, Rank n, T const &e) // 将e的n个副本插至秩r处
+{
+    if (n <= 0)
+        return r;
+    T x(e); // e可能就是本向量中的元素
+    uninitialized_fill_n(openGap(r, n), n, x);
+    return r;
+}
+
+template <typename T, typename Alloc, typename Growth>
+template <typename Pred>
+Rank Vector<T, Alloc, Growth>::erase_if(Pred pred) // 删除满足pred的所有元素，其余元素次序不变，一趟就地压缩
+{
+    Rank k = 0;
+    for (Rank i = 0; i < _size; i++)
+        if (!pred(_elem[i]))
+        {
+            if (k < i)
+                _elem[k] = std::move(_elem[i]);
+            k++;
+        }
+    Rank n = _size - k;
+    destroy(k, _size);
+    _size = k;
+    shrink();
+    return n;
+}
+
+template <typename T, typename Alloc, typename Growth>
+Rank Vector<T, Alloc, Growth>::remove(Rank lo, Rank hi)
+{
+    if (lo == hi)
+        return 0;
+    moveForward(_elem + lo, _elem + hi, _size - hi);
+    destroy(_size - (hi - lo), _size);
+    _size -= hi - lo;
     shrink();
     return hi - lo;
 }
 
-template <typename T>
-T Vector<T>::remove(Rank r)
+template <typename T, typename Alloc, typename Growth>
+T Vector<T, Alloc, Growth>::remove(Rank r)
 {
-    T e = _elem[r];
+    T e = std::move(_elem[r]);
     remove(r, r + 1);
     return e;
 }
 
-template <typename T>
-int Vector<T>::deduplicate()
+// 散列表槽位：对std::hash的结果再做一次乘法散列，以免恒等散列（如整数）在线性试探下聚集
+static inline size_t dedupSlot(size_t h, int bits)
+{
+    return (size_t)(((unsigned long long)h * 0x9E3779B97F4A7C15ull) >> (64 - bits));
+}
+
+template <typename T, typename Alloc, typename Growth>
+Rank Vector<T, Alloc, Growth>::deduplicate() // 散列去重：保留各元素首次出现者，相对次序不变，一趟就地压缩，期望O(n)
 {
-    int oldSize = _size;
-    Rank i = 1;
-    while (i < _size)
+    if (_size < 2)
+        return 0;
+    int bits = 1;
+    while ((Rank)1 << bits < _size << DEDUP_LOAD_SHIFT)
+        bits++;
+    size_t mask = ((size_t)1 << bits) - 1;
+    Rank *slot = new Rank[mask + 1]; // 槽中存放已保留元素的秩，-1为空
+    fill(slot, slot + mask + 1, -1);
+    hash<T> h;
+    Rank k = 0; // [0, k)为已保留的元素
+    for (Rank i = 0; i < _size; i++)
     {
-        (find(_elem[i], 0, i) < 0) ? i++ : remove(i);
+        size_t j = dedupSlot(h(_elem[i]), bits);
+        while (0 <= slot[j] && !(_elem[slot[j]] == _elem[i]))
+            j = (j + 1) & mask;
+        if (0 <= slot[j])
+            continue; // 重复
+        if (k < i)
+            _elem[k] = std::move(_elem[i]);
+        slot[j] = k++;
     }
-    return oldSize - _size;
+    delete[] slot;
+    Rank n = _size - k;
+    destroy(k, _size);
+    _size = k;
+    shrink();
+    return n;
 }
 
-template <typename T>
-void Vector<T>::traverse(void (*visit)(T &))
+template <typename T, typename Alloc, typename Growth>
+Rank Vector<T, Alloc, Growth>::deduplicate_ordered() // 排序去重：仅需<，适用于不可散列的类型；同样保留首次出现者的次序，O(nlogn)
 {
-    for (int i = 0; i < _size; i++)
+    if (_size < 2)
+        return 0;
+    T *A = _elem;
+    Rank *idx = new Rank[_size];
+    for (Rank i = 0; i < _size; i++)
+        idx[i] = i;
+    std::sort(idx, idx + _size, [A](Rank a, Rank b) { // 按(元素, 秩)排序：各组相等元素中秩最小者居首
+        return (A[a] < A[b]) || (!(A[b] < A[a]) && a < b);
+    });
+    char *keep = new char[_size];
+    keep[idx[0]] = 1;
+    for (Rank j = 1; j < _size; j++)
+        keep[idx[j]] = A[idx[j - 1]] < A[idx[j]];
+    delete[] idx;
+    Rank k = keepFlagged(keep);
+    delete[] keep;
+    Rank n = _size - k;
+    destroy(k, _size);
+    _size = k;
+    shrink();
+    return n;
+}
+
+template <typename T, typename Alloc, typename Growth>
+Rank Vector<T, Alloc, Growth>::keepFlagged(char const *keep) // 将keep[i]非零的元素依次前移，返回保留的个数；尾部留待调用者析构
+{
+    Rank k = 0;
+    for (Rank i = 0; i < _size; i++)
+        if (keep[i])
+        {
+            if (k < i)
+                _elem[k] = std::move(_elem[i]);
+            k++;
+        }
+    return k;
+}
+
+template <typename T, typename Alloc, typename Growth>
+void Vector<T, Alloc, Growth>::traverse(void (*visit)(T &))
+{
+    for (Rank i = 0; i < _size; i++)
         visit(_elem[i]);
 }
 
-template <typename T>
+template <typename T, typename Alloc, typename Growth>
 template <typename VST>
-void Vector<T>::traverse(VST &visit)
+void Vector<T, Alloc, Growth>::traverse(VST &&visit)
 {
-    for (int i = 0; i < _size; i++)
+    for (Rank i = 0; i < _size; i++)
         visit(_elem[i]);
 }
 
 template <typename T>
 struct Increase
 {
-    virtual void operator()(T &e) { e++; }
+    void operator()(T &e) const { e++; }
 };
-template <typename T>
-void increase(Vector<T> &V)
+template <typename T, typename Alloc, typename Growth>
+void increase(Vector<T, Alloc, Growth> &V)
 {
     V.traverse(Increase<T>());
 }
 
-template <typename T>
-int Vector<T>::disordered() const
+template <typename T, typename Alloc, typename Growth>
+Rank Vector<T, Alloc, Growth>::disordered() const
 {
-    int n = 0;
-    for (int i = 1; i < _size; i++)
-    {
-        if (_elem[i - 1] > _elem[i])
-            n++;
-    }
-    return n;
+    return countDescents(_elem, _size);
 }
 
-template <typename T>
-int Vector<T>::uniquify()
+template <typename T, typename Alloc, typename Growth>
+Rank Vector<T, Alloc, Growth>::uniquify()
 {
-    Rank i = 0, j = 0;
-    while (++j < _size)
-    {
-        if (_elem[i] != _elem[j])
-            _elem[++i] = _elem[j];
-    }
-    _size = ++i;
+    if (_size < 2)
+        return 0;
+    Rank i = compactRuns(_elem, _size), n = _size - i;
+    destroy(i, _size);
+    _size = i;
     shrink();
-    return j - i;
+    return n;
 }
 
 template <typename T>
@@ -289,71 +727,123 @@ static Rank fibSearch(T *A, T const &e, Rank lo, Rank hi)
     return -1;
 }
 
-template <typename T>
-Rank Vector<T>::search(T const &e, Rank lo, Rank hi) const
+template <typename T, typename Alloc, typename Growth>
+Rank Vector<T, Alloc, Growth>::search(T const &e, Rank lo, Rank hi) const
 {
-    return (rand() % 2) ? binSearch(_elem, e, lo, hi) : fibSearch(_elem, e, lo, hi);
+    return binSearch(_elem, e, lo, hi);
 }
 
-template <typename T>
-void Vector<T>::sort(Rank lo, Rank hi)
+// 与binSearch语义相同（返回不大于e的最后一个元素的秩），但循环次数只取决于区间长度，
+// 循环体中以条件传送代替分支，并预取下一轮可能访问的两个位置
+template <typename T, typename Alloc, typename Growth>
+Rank Vector<T, Alloc, Growth>::searchBranchless(T const &e, Rank lo, Rank hi) const
+{
+    if (hi <= lo)
+        return lo - 1;
+    T const *base = _elem + lo;
+    for (Rank n = hi - lo, half; 1 < n; n -= half)
+    {
+        half = n >> 1;
+        PREFETCH(base + (half >> 1));
+        PREFETCH(base + half + (half >> 1));
+        base = (e < base[half]) ? base : base + half;
+    }
+    return (Rank)(base - _elem) - (e < *base);
+}
+
+// 对有序向量批量查找：SEARCH_BATCH个查找交错推进，使各自的缓存缺失相互重叠
+template <typename T, typename Alloc, typename Growth>
+Vector<Rank> Vector<T, Alloc, Growth>::search_many(Vector const &keys) const
 {
-    switch (rand() % 5)
+    Vector<Rank> R(keys.size());
+    Rank m = keys.size(), i = 0;
+    if (_size == 0)
     {
-    case 1:
+        R.resize(m, -1);
+        return R;
+    }
+    for (; i + SEARCH_BATCH <= m; i += SEARCH_BATCH)
+    {
+        T const *base[SEARCH_BATCH];
+        for (int k = 0; k < SEARCH_BATCH; k++)
+            base[k] = _elem;
+        for (Rank n = _size, half; 1 < n; n -= half)
+        {
+            half = n >> 1;
+            for (int k = 0; k < SEARCH_BATCH; k++)
+            {
+                PREFETCH(base[k] + (half >> 1));
+                PREFETCH(base[k] + half + (half >> 1));
+                base[k] = (keys[i + k] < base[k][half]) ? base[k] : base[k] + half;
+            }
+        }
+        for (int k = 0; k < SEARCH_BATCH; k++)
+            R.emplace_back((Rank)(base[k] - _elem) - (keys[i + k] < *base[k]));
+    }
+    for (; i < m; i++)
+        R.emplace_back(searchBranchless(keys[i]));
+    return R;
+}
+
+template <typename T, typename Alloc, typename Growth>
+void Vector<T, Alloc, Growth>::sort(Rank lo, Rank hi)
+{
+    sort(lo, hi, SORT_INTRO);
+}
+
+template <typename T, typename Alloc, typename Growth>
+void Vector<T, Alloc, Growth>::sort(Rank lo, Rank hi, SortStrategy s)
+{
+    switch (s)
+    {
+    case SORT_BUBBLE:
         bubblesort(lo, hi);
         break;
-    case 2:
+    case SORT_SELECTION:
         selectionSort(lo, hi);
         break;
-    case 3:
+    case SORT_MERGE:
         mergeSort(lo, hi);
         break;
-    case 4:
+    case SORT_HEAP:
         heapSort(lo, hi);
         break;
-    default:
+    case SORT_QUICK:
         quickSort(lo, hi);
         break;
-    }
-}
-template <typename T>
-void Vector<T>::sort(Rank lo, Rank hi,int i)
-{
-    switch (i)
+    case SORT_MERGE_BOTTOM_UP:
     {
-    case 1:
-        bubblesort(lo, hi);
-        break;
-    case 2:
-        // selectionSort(lo, hi);
-        break;
-    case 3:
-        mergeSort(lo, hi);
-        break;
-    case 4:
-        // heapSort(lo, hi);
+        Rank n = bottomUpBufferSize(hi - lo);
+        T *B = allocate(n);
+        mergeSortBottomUp(lo, hi, B);
+        deallocate(B, n);
         break;
+    }
     default:
-        // quickSort(lo, hi);
+    {
+        int depth = 0; // 递归深度上限取2*log2(n)
+        for (Rank n = hi - lo; 1 < n; n >>= 1)
+            depth += 2;
+        introSort(lo, hi, depth);
         break;
     }
+    }
 }
 
-template <typename T>
-void Vector<T>::bubblesort(Rank lo, Rank hi)
+template <typename T, typename Alloc, typename Growth>
+void Vector<T, Alloc, Growth>::bubblesort(Rank lo, Rank hi)
 {
     while (!bubble(lo, hi--))
         ;
 }
 
-template <typename T>
-bool Vector<T>::bubble(Rank lo, Rank hi)
+template <typename T, typename Alloc, typename Growth>
+bool Vector<T, Alloc, Growth>::bubble(Rank lo, Rank hi)
 {
     bool sorted = true;
     while (++lo < hi)
     {
-        if (_elem[lo - 1] > _elem[lo])
+        if (_elem[lo] < _elem[lo - 1])
         {
             sorted = false;
             swap(_elem[lo - 1], _elem[lo]);
@@ -362,35 +852,217 @@ bool Vector<T>::bubble(Rank lo, Rank hi)
     return sorted;
 }
 
-template <typename T>
-void Vector<T>::mergeSort(Rank lo, Rank hi)
+template <typename T, typename Alloc, typename Growth>
+void Vector<T, Alloc, Growth>::mergeSort(Rank lo, Rank hi) // 整个排序只分配一次辅助空间
+{
+    Rank n = (hi - lo) >> 1;
+    T *B = allocate(n);
+    mergeSort(lo, hi, B);
+    deallocate(B, n);
+}
+
+template <typename T, typename Alloc, typename Growth>
+void Vector<T, Alloc, Growth>::mergeSort(Rank lo, Rank hi, Vector &scratch) // 借用scratch的空闲容量作为辅助空间，其中已有的元素不受影响
+{
+    scratch.reserve(scratch._size + ((hi - lo) >> 1));
+    mergeSort(lo, hi, scratch._elem + scratch._size);
+}
+
+template <typename T, typename Alloc, typename Growth>
+void Vector<T, Alloc, Growth>::mergeSortBottomUp(Rank lo, Rank hi, Vector &scratch)
 {
-    if (hi - lo < 2)
+    scratch.reserve(scratch._size + bottomUpBufferSize(hi - lo));
+    mergeSortBottomUp(lo, hi, scratch._elem + scratch._size);
+}
+
+template <typename T, typename Alloc, typename Growth>
+void Vector<T, Alloc, Growth>::mergeSort(Rank lo, Rank hi, T *B) // B为至少(hi - lo) / 2个元素的未初始化空间
+{
+    if (hi - lo <= INSERTION_SORT_THRESHOLD)
+    {
+        insertionSort(lo, hi);
         return;
-    int mi = (lo + hi) / 2;
-    mergeSort(lo, mi);
-    mergeSort(mi, hi);
-    merge(lo, mi, hi);
+    }
+    Rank mi = (lo + hi) >> 1;
+    mergeSort(lo, mi, B);
+    mergeSort(mi, hi, B);
+    if (_elem[mi] < _elem[mi - 1]) // 两段已整体有序时无需归并
+        merge(lo, mi, hi, B);
 }
 
-template <typename T>
-void Vector<T>::merge(Rank lo, Rank mi, Rank hi)
+template <typename T, typename Alloc, typename Growth>
+Rank Vector<T, Alloc, Growth>::bottomUpBufferSize(Rank n) // 自底向上归并时左段的最大长度
+{
+    Rank w = INSERTION_SORT_THRESHOLD, need = 0;
+    for (; w < n; w <<= 1)
+        need = w;
+    return need;
+}
+
+template <typename T, typename Alloc, typename Growth>
+void Vector<T, Alloc, Growth>::mergeSortBottomUp(Rank lo, Rank hi, T *B) // B为至少bottomUpBufferSize(hi - lo)个元素的未初始化空间
+{
+    for (Rank i = lo; i < hi; i += INSERTION_SORT_THRESHOLD)
+        insertionSort(i, (hi - i < INSERTION_SORT_THRESHOLD) ? hi : i + INSERTION_SORT_THRESHOLD);
+    for (Rank w = INSERTION_SORT_THRESHOLD; w < hi - lo; w <<= 1)
+        for (Rank i = lo; i < hi - w; i += w << 1)
+        {
+            Rank mi = i + w, j = (hi - mi < w) ? hi : mi + w;
+            if (_elem[mi] < _elem[mi - 1])
+                merge(i, mi, j, B);
+        }
+}
+
+template <typename T, typename Alloc, typename Growth>
+void Vector<T, Alloc, Growth>::merge(Rank lo, Rank mi, Rank hi, T *B) // 借助B暂存前半段，将[lo, mi)与[mi, hi)归并；稳定
 {
     T *A = _elem + lo;
-    int lb = mi - lo;
-    T *B = new T[lb];
-    for (Rank i = 0; i < lb; i++)
+    Rank lb = mi - lo;
+    T *C = _elem + mi;
+    Rank lc = hi - mi;
+    uninitialized_move(A, A + lb, B);
+    Rank i = 0, j = 0, k = 0;
+    while (j < lb && k < lc)
+        A[i++] = (C[k] < B[j]) ? std::move(C[k++]) : std::move(B[j++]);
+    while (j < lb) // 后半段的剩余元素已在原位
+        A[i++] = std::move(B[j++]);
+    std::destroy(B, B + lb);
+}
+
+template <typename T, typename Alloc, typename Growth>
+Rank Vector<T, Alloc, Growth>::max(Rank lo, Rank hi) // 在[lo, hi]内找出最大者，多个最大者时取秩最大的，故选择排序稳定
+{
+    Rank mx = hi;
+    while (lo < hi--)
+        if (_elem[mx] < _elem[hi])
+            mx = hi;
+    return mx;
+}
+
+template <typename T, typename Alloc, typename Growth>
+void Vector<T, Alloc, Growth>::selectionSort(Rank lo, Rank hi)
+{
+    while (lo < --hi)
+        swap(_elem[max(lo, hi)], _elem[hi]);
+}
+
+template <typename T, typename Alloc, typename Growth>
+void Vector<T, Alloc, Growth>::insertionSort(Rank lo, Rank hi)
+{
+    for (Rank i = lo + 1; i < hi; i++)
     {
-        B[i] = A[i];
+        if (!(_elem[i] < _elem[i - 1]))
+            continue;
+        T x = std::move(_elem[i]);
+        Rank j = i;
+        do
+            _elem[j] = std::move(_elem[j - 1]);
+        while (lo < --j && x < _elem[j - 1]);
+        _elem[j] = std::move(x);
     }
-    int lc = hi - mi;
-    T *C = _elem + mi;
-    for (Rank i = 0, j = 0, k = 0; (j < lb) || (k < lc);)
+}
+
+template <typename T, typename Alloc, typename Growth>
+void Vector<T, Alloc, Growth>::siftDown(Rank lo, Rank i, Rank n) // 以_elem + lo为根的n元大顶堆中，令第i个元素下滤
+{
+    T *H = _elem + lo;
+    T x = std::move(H[i]);
+    for (Rank c; (c = 2 * i + 1) < n; i = c)
+    {
+        if (c + 1 < n && H[c] < H[c + 1])
+            c++;
+        if (!(x < H[c]))
+            break;
+        H[i] = std::move(H[c]);
+    }
+    H[i] = std::move(x);
+}
+
+template <typename T, typename Alloc, typename Growth>
+void Vector<T, Alloc, Growth>::heapSort(Rank lo, Rank hi)
+{
+    Rank n = hi - lo;
+    for (Rank i = n / 2; 0 < i--;) // Floyd建堆
+        siftDown(lo, i, n);
+    while (1 < n)
     {
-        if ((j < lb) && (!(k < lc) || (B[j] <= C[k])))
-            A[i++] = B[j++];
-        if ((k < lc) && (!(j < lb) || (C[k] < B[j])))
-            A[i++] = C[k++];
+        swap(_elem[lo], _elem[lo + --n]);
+        siftDown(lo, 0, n);
     }
-    delete[] B;
-}
\ No newline at end of file
+}
+
+template <typename T, typename Alloc, typename Growth>
+Rank Vector<T, Alloc, Growth>::partition(Rank lo, Rank hi) // 轴点取三者中值；与轴点相等的元素交替归入两侧，重复元素多时依然均衡
+{
+    Rank mi = lo + ((hi - lo) >> 1);
+    if (_elem[mi] < _elem[lo])
+        swap(_elem[mi], _elem[lo]);
+    if (_elem[hi - 1] < _elem[mi])
+    {
+        swap(_elem[hi - 1], _elem[mi]);
+        if (_elem[mi] < _elem[lo])
+            swap(_elem[mi], _elem[lo]);
+    }
+    swap(_elem[lo], _elem[mi]);
+    T pivot = std::move(_elem[lo]);
+    hi--;
+    while (lo < hi)
+    {
+        while (lo < hi && pivot < _elem[hi])
+            hi--;
+        if (lo < hi)
+            _elem[lo++] = std::move(_elem[hi]);
+        while (lo < hi && _elem[lo] < pivot)
+            lo++;
+        if (lo < hi)
+            _elem[hi--] = std::move(_elem[lo]);
+    }
+    _elem[lo] = std::move(pivot);
+    return lo;
+}
+
+template <typename T, typename Alloc, typename Growth>
+void Vector<T, Alloc, Growth>::quickSort(Rank lo, Rank hi)
+{
+    while (1 < hi - lo) // 递归处理较短的一侧，循环处理较长的一侧，栈深度O(logn)
+    {
+        Rank mi = partition(lo, hi);
+        if (mi - lo < hi - mi)
+        {
+            quickSort(lo, mi);
+            lo = mi + 1;
+        }
+        else
+        {
+            quickSort(mi + 1, hi);
+            hi = mi;
+        }
+    }
+}
+
+template <typename T, typename Alloc, typename Growth>
+void Vector<T, Alloc, Growth>::introSort(Rank lo, Rank hi, int depth)
+{
+    while (INSERTION_SORT_THRESHOLD < hi - lo)
+    {
+        if (depth-- == 0) // 划分持续失衡，改用堆排序以保证O(nlogn)
+        {
+            heapSort(lo, hi);
+            return;
+        }
+        Rank mi = partition(lo, hi);
+        if (mi - lo < hi - mi)
+        {
+            introSort(lo, mi, depth);
+            lo = mi + 1;
+        }
+        else
+        {
+            introSort(mi + 1, hi, depth);
+            hi = mi;
+        }
+    }
+    insertionSort(lo, hi);
+}
+
+#endif
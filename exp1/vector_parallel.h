@@ -0,0 +1,254 @@
+#ifndef VECTOR_PARALLEL_H
+#define VECTOR_PARALLEL_H
+
+#include "vector.h"
+#include "threadpool.h"
+
+// Vector的多线程算法：parallel_sort、parallel_traverse、parallel_unsort
+// 依赖<thread>等，须以支持线程的工具链编译（GCC需-pthread），故与vector.h分开，按需包含
+
+#define PARALLEL_SORT_GRAIN 16384     // 并行排序中不再拆分的区间规模
+#define PARALLEL_TRAVERSE_GRAIN 65536 // 并行遍历中每个任务至少处理的元素数
+#define PARALLEL_SHUFFLE_GRAIN 65536  // 并行置乱中每个桶的平均规模
+#define PARALLEL_SHUFFLE_BUCKETS 256  // 并行置乱的最大桶数（桶号以一个字节记录）
+
+// 以V的友元身份实现各并行算法，供下方的parallel_*调用
+template <typename V>
+class VectorParallel
+{
+private:
+    typedef typename V::value_type T;
+    V &_v;
+
+    void mergeSort(Rank lo, Rank hi, T *B, ThreadPool &pool, int p);
+    void merge(Rank lo, Rank mi, Rank hi, T *B, ThreadPool &pool, int p);
+    void quickSort(Rank lo, Rank hi, ThreadPool &pool);
+
+public:
+    VectorParallel(V &v) : _v(v) {}
+    void sort(Rank lo, Rank hi, int threads, SortStrategy s);
+    template <typename VST>
+    void traverse(VST &&visit, Rank grain, int threads);
+    template <typename RNG>
+    void unsort(RNG &rng, int threads);
+};
+
+// 多线程排序，结果与V.sort(lo, hi, s)完全相同；目前支持SORT_MERGE与SORT_QUICK，其余策略按串行执行
+template <typename T, typename Alloc, typename Growth>
+void parallel_sort(Vector<T, Alloc, Growth> &V, Rank lo, Rank hi, int threads, SortStrategy s = SORT_MERGE)
+{
+    VectorParallel<Vector<T, Alloc, Growth>>(V).sort(lo, hi, threads, s);
+}
+template <typename T, typename Alloc, typename Growth>
+void parallel_sort(Vector<T, Alloc, Growth> &V, int threads, SortStrategy s = SORT_MERGE)
+{
+    parallel_sort(V, 0, V.size(), threads, s);
+}
+
+// 各线程共用visit，故visit须可并发调用（不修改共享状态）；threads为0时取硬件线程数
+template <typename T, typename Alloc, typename Growth, typename VST>
+void parallel_traverse(Vector<T, Alloc, Growth> &V, VST &&visit, Rank grain = PARALLEL_TRAVERSE_GRAIN, int threads = 0)
+{
+    VectorParallel<Vector<T, Alloc, Growth>>(V).traverse(std::forward<VST>(visit), grain, threads);
+}
+
+// 分桶置乱：结果只取决于rng与规模，与线程数无关
+template <typename T, typename Alloc, typename Growth, typename RNG>
+void parallel_unsort(Vector<T, Alloc, Growth> &V, RNG &rng, int threads = 0)
+{
+    VectorParallel<Vector<T, Alloc, Growth>>(V).unsort(rng, threads);
+}
+
+template <typename V>
+void VectorParallel<V>::sort(Rank lo, Rank hi, int threads, SortStrategy s)
+{
+    if (threads < 2 || hi - lo <= PARALLEL_SORT_GRAIN || (s != SORT_MERGE && s != SORT_QUICK))
+    {
+        _v.sort(lo, hi, s);
+        return;
+    }
+    ThreadPool pool(threads - 1); // 调用者自身也参与执行任务
+    if (s == SORT_QUICK)
+    {
+        quickSort(lo, hi, pool);
+        return;
+    }
+    T *B = _v.allocate(hi - lo);
+    mergeSort(lo, hi, B, pool, threads);
+    _v.deallocate(B, hi - lo);
+}
+
+template <typename V>
+void VectorParallel<V>::mergeSort(Rank lo, Rank hi, T *B, ThreadPool &pool, int p) // B为hi - lo个元素的未初始化空间
+{
+    if (hi - lo <= PARALLEL_SORT_GRAIN)
+    {
+        _v.mergeSort(lo, hi, B);
+        return;
+    }
+    Rank mi = (lo + hi) >> 1;
+    {
+        TaskGroup g(pool);
+        g.run([=, &pool]() { mergeSort(lo, mi, B, pool, p); });
+        mergeSort(mi, hi, B + (mi - lo), pool, p);
+    }
+    if (_v._elem[mi] < _v._elem[mi - 1])
+        merge(lo, mi, hi, B, pool, p);
+}
+
+// 按merge path将输出均分为若干段，各段独立归并至B，再搬回原处；与串行merge一样，相等元素取前段者优先
+template <typename V>
+void VectorParallel<V>::merge(Rank lo, Rank mi, Rank hi, T *B, ThreadPool &pool, int p)
+{
+    T *A = _v._elem + lo, *C = _v._elem + mi;
+    Rank la = mi - lo, lc = hi - mi, n = hi - lo;
+    int seg = (int)((p < n / PARALLEL_SORT_GRAIN) ? p : n / PARALLEL_SORT_GRAIN);
+    if (seg < 1)
+        seg = 1;
+    Rank *d = new Rank[seg + 1], *i = new Rank[seg + 1]; // 第t段输出为B[d[t], d[t + 1])，前d[t]个输出中有i[t]个来自A
+    for (int t = 0; t <= seg; t++) // 须在任何元素被移走前求出所有分点
+    {
+        d[t] = (Rank)((long long)n * t / seg);
+        Rank a = (d[t] < lc) ? 0 : d[t] - lc, b = (d[t] < la) ? d[t] : la;
+        while (a < b)
+        {
+            Rank m = (a + b) >> 1;
+            (C[d[t] - m - 1] < A[m]) ? b = m : a = m + 1;
+        }
+        i[t] = a;
+    }
+    TaskGroup g(pool);
+    for (int t = 0; t < seg; t++)
+        g.run([=]() {
+            T *out = B + d[t];
+            Rank ia = i[t], ic = d[t] - i[t], ea = i[t + 1], ec = d[t + 1] - i[t + 1];
+            while (ia < ea && ic < ec)
+                new (out++) T(std::move((C[ic] < A[ia]) ? C[ic++] : A[ia++]));
+            while (ia < ea)
+                new (out++) T(std::move(A[ia++]));
+            while (ic < ec)
+                new (out++) T(std::move(C[ic++]));
+        });
+    g.wait();
+    for (int t = 0; t < seg; t++)
+        g.run([=]() {
+            for (Rank k = d[t]; k < d[t + 1]; k++)
+            {
+                A[k] = std::move(B[k]);
+                B[k].~T();
+            }
+        });
+    g.wait();
+    delete[] d;
+    delete[] i;
+}
+
+template <typename V>
+void VectorParallel<V>::quickSort(Rank lo, Rank hi, ThreadPool &pool) // 与Vector::quickSort的划分完全一致，只是两侧并行处理
+{
+    TaskGroup g(pool);
+    while (PARALLEL_SORT_GRAIN < hi - lo)
+    {
+        Rank mi = _v.partition(lo, hi);
+        g.run([=, &pool]() { quickSort(lo, mi, pool); });
+        lo = mi + 1;
+    }
+    _v.quickSort(lo, hi);
+}
+
+template <typename V>
+template <typename VST>
+void VectorParallel<V>::traverse(VST &&visit, Rank grain, int threads)
+{
+    if (threads <= 0)
+        threads = (int)thread::hardware_concurrency();
+    Rank tasks = (grain < 1) ? _v._size : _v._size / grain; // 每段至少grain个元素，段数不超过线程数的4倍以便均衡
+    if (4 * (Rank)threads < tasks)
+        tasks = 4 * (Rank)threads;
+    if (threads < 2 || tasks < 2)
+    {
+        _v.traverse(visit);
+        return;
+    }
+    ThreadPool pool(threads - 1); // 调用者自身也参与执行任务
+    TaskGroup group(pool);
+    for (Rank t = 0; t < tasks; t++)
+    {
+        T *lo = _v._elem + _v._size * t / tasks, *hi = _v._elem + _v._size * (t + 1) / tasks;
+        group.run([&visit, lo, hi]() {
+            for (T *p = lo; p < hi; p++)
+                visit(*p);
+        });
+    }
+    group.wait();
+}
+
+template <typename V>
+template <typename RNG>
+void VectorParallel<V>::unsort(RNG &rng, int threads)
+{ // 各元素随机归入k个桶之一，再将各桶分别置乱后依次连接，所得排列仍是均匀的
+    Rank n = _v._size;
+    Rank k = n / PARALLEL_SHUFFLE_GRAIN;
+    if (PARALLEL_SHUFFLE_BUCKETS < k)
+        k = PARALLEL_SHUFFLE_BUCKETS;
+    if (threads <= 0)
+        threads = (int)thread::hardware_concurrency();
+    if (k < 2)
+    {
+        _v.unsort(rng);
+        return;
+    }
+    Xoshiro256 *g = new Xoshiro256[2 * k]; // 前k个用于第c段的分桶，后k个用于第b桶的置乱
+    for (Rank i = 0; i < 2 * k; i++)
+        g[i].seed(rng());
+    unsigned char *tag = new unsigned char[n];
+    Rank *offset = new Rank[k * k]; // offset[c * k + b]：第c段中归入第b桶的元素个数，随后改为其写入位置
+    fill(offset, offset + k * k, 0);
+    ThreadPool pool(threads - 1);
+    {
+        TaskGroup group(pool);
+        for (Rank c = 0; c < k; c++)
+            group.run([n, c, k, g, tag, offset]() {
+                Rank *count = offset + c * k;
+                for (Rank i = n * c / k; i < n * (c + 1) / k; i++)
+                    count[tag[i] = (unsigned char)uniformBelow(g[c], k)]++;
+            });
+    }
+    Rank sum = 0; // 桶为主序、段为次序的前缀和
+    for (Rank b = 0; b < k; b++)
+        for (Rank c = 0; c < k; c++)
+        {
+            Rank m = offset[c * k + b];
+            offset[c * k + b] = sum;
+            sum += m;
+        }
+    Rank *bucket = new Rank[k + 1]; // 第b桶为[bucket[b], bucket[b + 1])
+    for (Rank b = 0; b < k; b++)
+        bucket[b] = offset[b];
+    bucket[k] = n;
+    T *B = _v.allocate(_v._capacity);
+    T *A = _v._elem;
+    {
+        TaskGroup group(pool);
+        for (Rank c = 0; c < k; c++)
+            group.run([n, c, k, tag, offset, A, B]() {
+                Rank *next = offset + c * k;
+                for (Rank i = n * c / k; i < n * (c + 1) / k; i++)
+                    relocate(B + next[tag[i]]++, A + i, 1);
+            });
+    }
+    _v.deallocate(A, _v._capacity); // 元素已全部迁入B
+    _v._elem = B;
+    {
+        TaskGroup group(pool);
+        V &v = _v;
+        for (Rank b = 0; b < k; b++)
+            group.run([&v, b, k, g, bucket]() { v.unsort(bucket[b], bucket[b + 1], g[k + b]); });
+    }
+    delete[] bucket;
+    delete[] offset;
+    delete[] tag;
+    delete[] g;
+}
+
+#endif
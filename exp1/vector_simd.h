@@ -0,0 +1,292 @@
+#ifndef VECTOR_SIMD_H
+#define VECTOR_SIMD_H
+
+// Vector::find、disordered、uniquify的底层实现
+// 通用版本为模板；int、float、double另有SSE2/AVX2版本的重载，运行时按CPU支持的指令集选用
+
+template <typename T>
+static Rank findLast(T const *A, T const &e, Rank lo, Rank hi) // 在[lo, hi)中逆向查找e，失败时返回lo - 1
+{
+    while ((lo < hi--) && (e != A[hi]))
+        ;
+    return hi;
+}
+
+template <typename T>
+static Rank countDescents(T const *A, Rank n) // 相邻逆序对的数目
+{
+    Rank k = 0;
+    for (Rank i = 1; i < n; i++)
+        if (A[i] < A[i - 1])
+            k++;
+    return k;
+}
+
+template <typename T>
+static Rank compactRuns(T *A, Rank n) // 每组连续相等的元素只保留首个，返回保留的元素数；n >= 1
+{
+    Rank i = 0, j = 0;
+    while (++j < n)
+        if (A[i] != A[j])
+            A[++i] = std::move(A[j]);
+    return i + 1;
+}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define VECTOR_SIMD
+#include <immintrin.h>
+#include <cstring>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi" // 核心例程只在同指令集的入口中内联展开，不存在跨ABI的调用
+
+#define SIMD_SSE2 __attribute__((target("sse2")))
+#define SIMD_AVX2 __attribute__((target("avx2")))
+#define SIMD_INLINE inline __attribute__((always_inline))
+
+inline int detectSimdLevel()
+{
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") ? 2 : __builtin_cpu_supports("sse2") ? 1 : 0;
+}
+
+inline int simdLevel() // 0：无；1：SSE2；2：AVX2；局部静态量的初始化是线程安全的，多线程同时查询亦无竞争
+{
+    static const int level = detectSimdLevel();
+    return level;
+}
+
+// AVX2压缩用的置换表：第m项将掩码m中为1的各通道依次移至低位
+struct CompressTable
+{
+    int idx32[256][8]; // 8个32位通道
+    int idx64[16][8];  // 4个64位通道，每个通道对应一对32位下标
+    CompressTable()
+    {
+        memset(this, 0, sizeof(*this));
+        for (int m = 0; m < 256; m++)
+            for (int t = 0, k = 0; t < 8; t++)
+                if ((m >> t) & 1)
+                    idx32[m][k++] = t;
+        for (int m = 0; m < 16; m++)
+            for (int t = 0, k = 0; t < 4; t++)
+                if ((m >> t) & 1)
+                {
+                    idx64[m][2 * k] = 2 * t;
+                    idx64[m][2 * k + 1] = 2 * t + 1;
+                    k++;
+                }
+    }
+};
+
+inline CompressTable const &compressTable()
+{
+    static CompressTable table;
+    return table;
+}
+
+// 各指令集、各类型的基本操作：W为每个向量的元素数，eq/lt返回逐元素比较结果的位掩码，
+// compress（仅AVX2）将x中掩码为1的通道依次写至dst，可能写满dst起的W个位置
+struct Sse2Int
+{
+    typedef int T;
+    typedef __m128i V;
+    enum { W = 4 };
+    SIMD_SSE2 static V load(T const *p) { return _mm_loadu_si128((__m128i const *)p); }
+    SIMD_SSE2 static V set1(T e) { return _mm_set1_epi32(e); }
+    SIMD_SSE2 static int eq(V a, V b) { return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, b))); }
+    SIMD_SSE2 static int lt(V a, V b) { return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmplt_epi32(a, b))); }
+};
+struct Sse2Float
+{
+    typedef float T;
+    typedef __m128 V;
+    enum { W = 4 };
+    SIMD_SSE2 static V load(T const *p) { return _mm_loadu_ps(p); }
+    SIMD_SSE2 static V set1(T e) { return _mm_set1_ps(e); }
+    SIMD_SSE2 static int eq(V a, V b) { return _mm_movemask_ps(_mm_cmpeq_ps(a, b)); }
+    SIMD_SSE2 static int lt(V a, V b) { return _mm_movemask_ps(_mm_cmplt_ps(a, b)); }
+};
+struct Sse2Double
+{
+    typedef double T;
+    typedef __m128d V;
+    enum { W = 2 };
+    SIMD_SSE2 static V load(T const *p) { return _mm_loadu_pd(p); }
+    SIMD_SSE2 static V set1(T e) { return _mm_set1_pd(e); }
+    SIMD_SSE2 static int eq(V a, V b) { return _mm_movemask_pd(_mm_cmpeq_pd(a, b)); }
+    SIMD_SSE2 static int lt(V a, V b) { return _mm_movemask_pd(_mm_cmplt_pd(a, b)); }
+};
+struct Avx2Int
+{
+    typedef int T;
+    typedef __m256i V;
+    enum { W = 8 };
+    SIMD_AVX2 static V load(T const *p) { return _mm256_loadu_si256((__m256i const *)p); }
+    SIMD_AVX2 static V set1(T e) { return _mm256_set1_epi32(e); }
+    SIMD_AVX2 static int eq(V a, V b) { return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b))); }
+    SIMD_AVX2 static int lt(V a, V b) { return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(b, a))); }
+    SIMD_AVX2 static void compress(T *dst, V x, int keep)
+    {
+        _mm256_storeu_si256((__m256i *)dst, _mm256_permutevar8x32_epi32(x, _mm256_loadu_si256((__m256i const *)compressTable().idx32[keep])));
+    }
+};
+struct Avx2Float
+{
+    typedef float T;
+    typedef __m256 V;
+    enum { W = 8 };
+    SIMD_AVX2 static V load(T const *p) { return _mm256_loadu_ps(p); }
+    SIMD_AVX2 static V set1(T e) { return _mm256_set1_ps(e); }
+    SIMD_AVX2 static int eq(V a, V b) { return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ)); }
+    SIMD_AVX2 static int lt(V a, V b) { return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_LT_OQ)); }
+    SIMD_AVX2 static void compress(T *dst, V x, int keep)
+    {
+        _mm256_storeu_ps(dst, _mm256_permutevar8x32_ps(x, _mm256_loadu_si256((__m256i const *)compressTable().idx32[keep])));
+    }
+};
+struct Avx2Double
+{
+    typedef double T;
+    typedef __m256d V;
+    enum { W = 4 };
+    SIMD_AVX2 static V load(T const *p) { return _mm256_loadu_pd(p); }
+    SIMD_AVX2 static V set1(T e) { return _mm256_set1_pd(e); }
+    SIMD_AVX2 static int eq(V a, V b) { return _mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_EQ_OQ)); }
+    SIMD_AVX2 static int lt(V a, V b) { return _mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_LT_OQ)); }
+    SIMD_AVX2 static void compress(T *dst, V x, int keep)
+    {
+        _mm256_storeu_pd(dst, _mm256_castps_pd(_mm256_permutevar8x32_ps(_mm256_castpd_ps(x), _mm256_loadu_si256((__m256i const *)compressTable().idx64[keep]))));
+    }
+};
+
+// 以下核心例程总是内联进带target属性的入口函数，从而按该入口的指令集编译
+template <typename Op>
+static SIMD_INLINE Rank findLastKernel(typename Op::T const *A, typename Op::T e, Rank lo, Rank hi)
+{
+    typename Op::V v = Op::set1(e);
+    while (2 * Op::W <= hi - lo) // 每轮比较两个向量
+    {
+        hi -= 2 * Op::W;
+        int m = Op::eq(Op::load(A + hi), v) | (Op::eq(Op::load(A + hi + Op::W), v) << Op::W);
+        if (m)
+            return hi + 31 - __builtin_clz(m);
+    }
+    return findLast(A, e, lo, hi);
+}
+
+template <typename Op>
+static SIMD_INLINE Rank countDescentsKernel(typename Op::T const *A, Rank n)
+{
+    Rank k = 0, i = 1;
+    for (; i + Op::W <= n; i += Op::W)
+        k += __builtin_popcount(Op::lt(Op::load(A + i), Op::load(A + i - 1)));
+    for (; i < n; i++)
+        if (A[i] < A[i - 1])
+            k++;
+    return k;
+}
+
+template <typename Op>
+static SIMD_INLINE Rank compactRunsKernel(typename Op::T *A, Rank n) // 保留与前驱不等者
+{
+    typedef typename Op::T T;
+    Rank k = 1, j = 1;
+    T prev = A[0];
+    if (j + Op::W <= n)
+    {
+        typename Op::V x = Op::load(A + j), y = Op::load(A + j - 1);
+        while (true) // 下一轮的输入在本轮写出之前读取，避免读取刚写入的位置时的store forwarding停顿
+        {
+            int keep = ~Op::eq(x, y) & ((1 << Op::W) - 1);
+            prev = A[j + Op::W - 1];
+            bool more = j + 2 * Op::W <= n;
+            typename Op::V xn = x, yn = y;
+            if (more)
+            {
+                xn = Op::load(A + j + Op::W);
+                yn = Op::load(A + j + Op::W - 1);
+            }
+            Op::compress(A + k, x, keep); // k <= j，写入不会越过本轮已读取的范围
+            k += __builtin_popcount(keep);
+            j += Op::W;
+            if (!more)
+                break;
+            x = xn;
+            y = yn;
+        }
+    }
+    for (; j < n; j++) // A[j - 1]可能已被覆盖，以prev为前驱
+    {
+        T cur = A[j];
+        if (cur != prev)
+            A[k++] = cur;
+        prev = cur;
+    }
+    return k;
+}
+
+SIMD_SSE2 inline Rank findLastSse2(int const *A, int e, Rank lo, Rank hi) { return findLastKernel<Sse2Int>(A, e, lo, hi); }
+SIMD_SSE2 inline Rank findLastSse2(float const *A, float e, Rank lo, Rank hi) { return findLastKernel<Sse2Float>(A, e, lo, hi); }
+SIMD_SSE2 inline Rank findLastSse2(double const *A, double e, Rank lo, Rank hi) { return findLastKernel<Sse2Double>(A, e, lo, hi); }
+SIMD_AVX2 inline Rank findLastAvx2(int const *A, int e, Rank lo, Rank hi) { return findLastKernel<Avx2Int>(A, e, lo, hi); }
+SIMD_AVX2 inline Rank findLastAvx2(float const *A, float e, Rank lo, Rank hi) { return findLastKernel<Avx2Float>(A, e, lo, hi); }
+SIMD_AVX2 inline Rank findLastAvx2(double const *A, double e, Rank lo, Rank hi) { return findLastKernel<Avx2Double>(A, e, lo, hi); }
+
+SIMD_SSE2 inline Rank countDescentsSse2(int const *A, Rank n) { return countDescentsKernel<Sse2Int>(A, n); }
+SIMD_SSE2 inline Rank countDescentsSse2(float const *A, Rank n) { return countDescentsKernel<Sse2Float>(A, n); }
+SIMD_SSE2 inline Rank countDescentsSse2(double const *A, Rank n) { return countDescentsKernel<Sse2Double>(A, n); }
+SIMD_AVX2 inline Rank countDescentsAvx2(int const *A, Rank n) { return countDescentsKernel<Avx2Int>(A, n); }
+SIMD_AVX2 inline Rank countDescentsAvx2(float const *A, Rank n) { return countDescentsKernel<Avx2Float>(A, n); }
+SIMD_AVX2 inline Rank countDescentsAvx2(double const *A, Rank n) { return countDescentsKernel<Avx2Double>(A, n); }
+
+SIMD_AVX2 inline Rank compactRunsAvx2(int *A, Rank n) { return compactRunsKernel<Avx2Int>(A, n); }
+SIMD_AVX2 inline Rank compactRunsAvx2(float *A, Rank n) { return compactRunsKernel<Avx2Float>(A, n); }
+SIMD_AVX2 inline Rank compactRunsAvx2(double *A, Rank n) { return compactRunsKernel<Avx2Double>(A, n); }
+
+// 供Vector调用的重载：优于通用模板被选中，再按运行时检测到的指令集分派
+#define SIMD_DISPATCH(T)                                                  \
+    inline Rank findLast(T const *A, T const &e, Rank lo, Rank hi)        \
+    {                                                                     \
+        switch (simdLevel())                                              \
+        {                                                                 \
+        case 2:                                                           \
+            return findLastAvx2(A, e, lo, hi);                            \
+        case 1:                                                           \
+            return findLastSse2(A, e, lo, hi);                            \
+        default:                                                          \
+            return findLast<T>(A, e, lo, hi);                             \
+        }                                                                 \
+    }                                                                     \
+    inline Rank countDescents(T const *A, Rank n)                         \
+    {                                                                     \
+        switch (simdLevel())                                              \
+        {                                                                 \
+        case 2:                                                           \
+            return countDescentsAvx2(A, n);                               \
+        case 1:                                                           \
+            return countDescentsSse2(A, n);                               \
+        default:                                                          \
+            return countDescents<T>(A, n);                                \
+        }                                                                 \
+    }                                                                     \
+    inline Rank compactRuns(T *A, Rank n)                                 \
+    {                                                                     \
+        switch (simdLevel())                                              \
+        {                                                                 \
+        case 2:                                                           \
+            return compactRunsAvx2(A, n);                                 \
+        default: /* SSE2下逐通道压缩不及可预测的分支，不予向量化 */         \
+            return compactRuns<T>(A, n);                                  \
+        }                                                                 \
+    }
+
+SIMD_DISPATCH(int)
+SIMD_DISPATCH(float)
+SIMD_DISPATCH(double)
+#undef SIMD_DISPATCH
+
+#pragma GCC diagnostic pop
+#endif
+
+#endif